@@ -0,0 +1,408 @@
+#include "AtpgRunner.h"
+#include "PodemSolver.h"
+#include "SimState.h"
+#include "FaultSimulator.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// Helper to print test vectors
+static char printPIValue(LogicValue v) {
+    switch(v) {
+        case LogicValue::ZERO: return '0';
+        case LogicValue::ONE:  return '1';
+        case LogicValue::D:    return '1'; // D means 1 in good, 0 in bad
+        case LogicValue::DBAR: return '0'; // DBAR means 0 in good, 1 in bad
+        default:               return 'X';
+    }
+}
+
+// Inverse of printPIValue, for fault-simulating a vector
+static std::vector<LogicValue> parseVector(const std::string& vector) {
+    std::vector<LogicValue> piValues(vector.size());
+    for (size_t i = 0; i < piValues.size(); ++i) {
+        char c = vector[i];
+        piValues[i] = (c == '1') ? LogicValue::ONE : (c == '0') ? LogicValue::ZERO : LogicValue::X;
+    }
+    return piValues;
+}
+
+// Faults ahead that extendCube fault-simulates the cube against at once
+static const size_t SECONDARY_WINDOW = 256;
+
+AtpgRunner::AtpgRunner(const Netlist& n, const AtpgOptions& opts)
+    : netlist(n), options(opts) {}
+
+AtpgRunner::~AtpgRunner() = default;
+
+// Runs PODEM for a single fault on the given state
+FaultResult AtpgRunner::solveFault(SimState& state, const std::vector<FaultSpec>& faults, size_t f,
+                                   long backtrackLimit, long timeLimitMs, const std::string& fixedCube) const {
+    FaultResult result;
+    if (faultSites[f] < 0) {
+        result.status = FaultResult::Status::ERROR;
+        result.errorMsg = "Fault gate not found: " + faults[f].gateName;
+        return result;
+    }
+
+    // Reset all values to UNSET/X
+    state.clearAllValues();
+
+    try {
+        // Create the solver
+        PodemSolver solver(netlist, state, faultSites[f], faultTypes[f], options.useScoap);
+        solver.setLimits(backtrackLimit, timeLimitMs);
+        solver.setLearnedImplications(learned);
+        if (!fixedCube.empty()) {
+            std::vector<LogicValue> piValues(fixedCube.size());
+            for (size_t i = 0; i < piValues.size(); ++i) {
+                char c = fixedCube[i];
+                piValues[i] = (c == '1') ? LogicValue::ONE : (c == '0') ? LogicValue::ZERO : LogicValue::X;
+            }
+            solver.setFixedPIs(piValues);
+        }
+
+        // Run the solver
+        std::vector<LogicValue> piValues;
+        bool found = solver.solve(piValues);
+        result.backtracks = solver.getBacktrackCount();
+        result.pruned = solver.getPrunedCount();
+        result.learnedPruned = solver.getLearnedPrunedCount();
+        result.ruledOutByLearning = solver.wasRuledOutByLearning();
+        result.stats = solver.getStats();
+        if (found) {
+            result.status = FaultResult::Status::TEST_FOUND;
+            result.vector.reserve(piValues.size());
+            for (LogicValue v : piValues) {
+                result.vector += printPIValue(v);
+            }
+        } else if (solver.wasAborted()) {
+            result.status = FaultResult::Status::ABORTED;
+        } else {
+            result.status = FaultResult::Status::NONE_FOUND;
+        }
+
+    } catch (const std::exception& e) {
+        result.status = FaultResult::Status::ERROR;
+        result.errorMsg = e.what();
+    }
+    return result;
+}
+
+bool AtpgRunner::isCovered(size_t f) const {
+    return coveredBy[f].load(std::memory_order_acquire) >= 0;
+}
+
+void AtpgRunner::run(const std::vector<FaultSpec>& faults, ResultWriter& out) {
+    coveredBy = std::vector<std::atomic<int>>(faults.size());
+    for (auto& c : coveredBy) {
+        c.store(-1);
+    }
+    vectorLines.assign(faults.size(), std::string());
+    aborted.assign(faults.size(), 0);
+    faultSites.resize(faults.size());
+    faultTypes.resize(faults.size());
+    for (size_t f = 0; f < faults.size(); ++f) {
+        faultSites[f] = netlist.findGate(faults[f].gateName);
+        faultTypes[f] = (faults[f].value == 0) ? FaultType::SA0 : FaultType::SA1;
+    }
+    if (options.dynamicCompaction) {
+        // Secondary targeting depends on which faults are still undetected
+        options.dropFaults = true;
+        options.threads = 1;
+    }
+    if (options.dropFaults) {
+        dropSimulator = std::make_unique<FaultSimulator>(netlist);
+    }
+    if (options.staticLearning && !learned) {
+        ownLearned = LearnedImplications::learn(netlist, options.learnTimeLimitMs);
+        learned = ownLearned.get();
+    }
+
+    bool hasBudget = options.backtrackLimit > 0 || options.timeLimitMs > 0;
+    deferOutput = hasBudget && options.retryScale > 1;
+    deferredLines.assign(deferOutput ? faults.size() : 0, std::string());
+
+    std::vector<size_t> order(faults.size());
+    for (size_t f = 0; f < faults.size(); ++f) {
+        order[f] = f;
+    }
+    pass = 0;
+    auto runPass = [&](int scale) {
+        pass++;
+        progressDone = 0;
+        progressTotal = order.size();
+        progressStart = progressShown = std::chrono::steady_clock::now();
+        if (options.threads > 1) {
+            runParallel(faults, order, scale, out);
+        } else {
+            runSequential(faults, order, scale, out);
+        }
+        reportProgress(true);
+    };
+    runPass(1);
+
+    // Second pass: only the aborted faults, in file order, with a larger budget
+    if (deferOutput) {
+        order.clear();
+        for (size_t f = 0; f < faults.size(); ++f) {
+            if (aborted[f]) {
+                order.push_back(f);
+            }
+        }
+        if (!order.empty()) {
+            if (!options.quiet) {
+                std::cout << "Retrying " << order.size() << " aborted faults with "
+                          << options.retryScale << "x the budget" << std::endl;
+            }
+            runPass(options.retryScale);
+        }
+        for (const std::string& line : deferredLines) {
+            out.writeLine(line);
+        }
+    }
+    out.flush();
+}
+
+size_t AtpgRunner::getAbortedCount() const {
+    size_t count = 0;
+    for (char a : aborted) {
+        count += a;
+    }
+    return count;
+}
+
+void AtpgRunner::runSequential(const std::vector<FaultSpec>& faults, const std::vector<size_t>& order,
+                               int scale, ResultWriter& out) {
+    SimState state(netlist);
+    for (size_t f : order) {
+        FaultResult result;
+        if (!isCovered(f)) {
+            result = solveFault(state, faults, f, options.backtrackLimit * scale, options.timeLimitMs * scale);
+            if (options.dynamicCompaction && result.status == FaultResult::Status::TEST_FOUND) {
+                extendCube(state, faults, f, result);
+            }
+        }
+        emitResult(faults, f, result, out);
+    }
+}
+
+void AtpgRunner::runParallel(const std::vector<FaultSpec>& faults, const std::vector<size_t>& order,
+                             int scale, ResultWriter& out) {
+    std::vector<FaultResult> results(faults.size());
+    std::vector<char> ready(faults.size(), 0);
+    std::atomic<size_t> nextFault(0);
+    std::mutex readyMutex;
+    std::condition_variable readyCond;
+
+    // Workers pull faults from the shared counter, each on its own state.
+    // The netlist is only read while they run.
+    auto worker = [&]() {
+        SimState state(netlist);
+        size_t next;
+        while ((next = nextFault.fetch_add(1)) < order.size()) {
+            size_t f = order[next];
+            if (isCovered(f)) {
+                continue; // The writer will never wait for this one
+            }
+            FaultResult result = solveFault(state, faults, f, options.backtrackLimit * scale,
+                                            options.timeLimitMs * scale);
+            {
+                std::lock_guard<std::mutex> lock(readyMutex);
+                results[f] = std::move(result);
+                ready[f] = 1;
+            }
+            readyCond.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < options.threads; ++t) {
+        pool.emplace_back(worker);
+    }
+
+    // Reorder stage: write results strictly in fault-file order
+    for (size_t f : order) {
+        if (isCovered(f)) {
+            emitResult(faults, f, FaultResult(), out);
+            continue;
+        }
+        FaultResult result;
+        {
+            std::unique_lock<std::mutex> lock(readyMutex);
+            readyCond.wait(lock, [&]() { return ready[f] != 0; });
+            result = std::move(results[f]);
+        }
+        emitResult(faults, f, result, out);
+    }
+
+    for (std::thread& t : pool) {
+        t.join();
+    }
+}
+
+void AtpgRunner::emitResult(const std::vector<FaultSpec>& faults, size_t f,
+                            const FaultResult& result, ResultWriter& out) {
+    const FaultSpec& spec = faults[f];
+
+    if (statsReport) {
+        static const char* const statusNames[] = {"test_found", "none_found", "aborted", "error"};
+        const char* status = isCovered(f) ? "dropped" : statusNames[int(result.status)];
+        statsReport->record(spec.gateName, spec.value, pass, status, result.backtracks, result.pruned,
+                            result.stats);
+    }
+    if (options.progress) {
+        progressDone++;
+        reportProgress(false);
+    }
+
+    aborted[f] = 0;
+    if (isCovered(f)) {
+        const FaultSpec& cover = faults[coveredBy[f]];
+        writeLine(f, vectorLines[coveredBy[f]], out);
+        if (!options.quiet) {
+            std::cout << "Fault: " << spec.gateName << "/" << spec.value << " -> DROPPED (covered by "
+                      << cover.gateName << "/" << cover.value << ")\n";
+        }
+        return;
+    }
+
+    totalBacktracks += result.backtracks;
+    totalPruned += result.pruned;
+    totalLearnedPruned += result.learnedPruned;
+    ruledOutCount += result.ruledOutByLearning ? 1 : 0;
+    switch (result.status) {
+        case FaultResult::Status::TEST_FOUND:
+            patternCount++;
+            writeLine(f, result.vector, out);
+            if (!options.quiet) {
+                std::cout << "Fault: " << spec.gateName << "/" << spec.value << " -> TEST FOUND ("
+                          << result.backtracks << " backtracks, " << result.pruned << " pruned)\n";
+            }
+            break;
+        case FaultResult::Status::NONE_FOUND:
+            writeLine(f, "none found", out);
+            if (!options.quiet) {
+                std::cout << "Fault: " << spec.gateName << "/" << spec.value << " -> none found ("
+                          << result.backtracks << " backtracks, " << result.pruned << " pruned)\n";
+            }
+            return;
+        case FaultResult::Status::ABORTED:
+            aborted[f] = 1;
+            writeLine(f, "aborted", out);
+            if (!options.quiet) {
+                std::cout << "Fault: " << spec.gateName << "/" << spec.value << " -> ABORTED ("
+                          << result.backtracks << " backtracks, " << result.pruned << " pruned)\n";
+            }
+            return;
+        case FaultResult::Status::ERROR:
+            std::cerr << "Error processing fault " << spec.gateName << ": " << result.errorMsg << std::endl;
+            writeLine(f, "error", out);
+            return;
+    }
+
+    if (!options.dropFaults) {
+        return;
+    }
+
+    // Fault-simulate the new vector against every fault still pending
+    vectorLines[f] = result.vector;
+    FaultSimulator& simulator = *dropSimulator;
+    simulator.clearPatterns();
+    simulator.addPattern(parseVector(result.vector));
+    simulator.simulateGood();
+    for (size_t j = f + 1; j < faults.size(); ++j) {
+        int site = faultSites[j];
+        if (isCovered(j) || site < 0) {
+            continue;
+        }
+        if (deferOutput && !deferredLines[j].empty() && !aborted[j]) {
+            continue; // Already final from the first pass
+        }
+        if (simulator.simulateFault(site, faultTypes[j]) >= 0) {
+            coveredBy[j].store(f, std::memory_order_release);
+        }
+    }
+}
+
+void AtpgRunner::extendCube(SimState& state, const std::vector<FaultSpec>& faults, size_t f,
+                            FaultResult& result) {
+    // Faults the cube already detects need no attempt of their own. The
+    // cube is fault-simulated against the next SECONDARY_WINDOW faults,
+    // and again from the next fault on whenever a secondary target has
+    // changed it.
+    FaultSimulator& simulator = *dropSimulator;
+    std::vector<char> detected;
+    size_t windowStart = 0;
+    size_t windowEnd = 0;
+    int attempts = 0;
+    for (size_t g = f + 1; g < faults.size() && attempts < options.secondaryTargets; ++g) {
+        if (result.vector.find('X') == std::string::npos) {
+            break; // Cube is full
+        }
+        if (isCovered(g)) {
+            continue;
+        }
+        if (g >= windowEnd) {
+            windowStart = g;
+            windowEnd = std::min(g + SECONDARY_WINDOW, faults.size());
+            detected.assign(windowEnd - windowStart, 0);
+            simulator.clearPatterns();
+            simulator.addPattern(parseVector(result.vector));
+            simulator.simulateGood();
+            for (size_t j = windowStart; j < windowEnd; ++j) {
+                if (faultSites[j] >= 0 && !isCovered(j)) {
+                    detected[j - windowStart] = simulator.simulateFault(faultSites[j], faultTypes[j]) >= 0;
+                }
+            }
+        }
+        if (detected[g - windowStart]) {
+            continue;
+        }
+        attempts++;
+        FaultResult secondary = solveFault(state, faults, g, options.secondaryBacktrackLimit, 0, result.vector);
+        result.backtracks += secondary.backtracks;
+        result.pruned += secondary.pruned;
+        result.learnedPruned += secondary.learnedPruned;
+        result.stats.add(secondary.stats);
+        if (secondary.status == FaultResult::Status::TEST_FOUND) {
+            // Only X positions can change, so every earlier target stays detected
+            result.vector = secondary.vector;
+            windowEnd = g + 1;
+        }
+    }
+}
+
+void AtpgRunner::writeLine(size_t f, const std::string& line, ResultWriter& out) {
+    if (deferOutput) {
+        deferredLines[f] = line;
+    } else {
+        out.writeLine(line);
+    }
+}
+
+// Rewrites one stderr line with the faults done, the rate and the time
+// left, at most twice a second
+void AtpgRunner::reportProgress(bool done) {
+    if (!options.progress) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (!done && now - progressShown < std::chrono::milliseconds(500)) {
+        return;
+    }
+    progressShown = now;
+    double seconds = std::chrono::duration<double>(now - progressStart).count();
+    double rate = (seconds > 0) ? progressDone / seconds : 0;
+    long eta = (rate > 0) ? long((progressTotal - progressDone) / rate + 0.5) : 0;
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "\r%s%zu/%zu faults (%.1f%%), %.1f faults/s, ETA %ld:%02ld:%02ld  ",
+                  pass > 1 ? "Retry: " : "", progressDone, progressTotal,
+                  progressTotal ? 100.0 * progressDone / progressTotal : 100.0, rate, eta / 3600,
+                  eta / 60 % 60, eta % 60);
+    std::cerr << line << (done ? "\n" : "") << std::flush;
+}
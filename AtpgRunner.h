@@ -0,0 +1,158 @@
+#ifndef ATPG_RUNNER_H
+#define ATPG_RUNNER_H
+
+#include "Netlist.h"
+#include "ResultWriter.h"
+#include "SearchStats.h"
+#include "StaticLearning.h"
+#include "logic.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+class FaultSimulator;
+class SimState;
+
+// One line of a .fault file
+struct FaultSpec {
+    std::string gateName;
+    int value; // 0 = stuck-at-0, 1 = stuck-at-1
+};
+
+struct AtpgOptions {
+    bool dropFaults = false; // Reuse earlier vectors for faults they detect
+    int threads = 1;         // Worker threads running PODEM
+    bool useScoap = false;   // Let SCOAP measures guide backtrace and D-frontier choice
+
+    // Per-fault budgets, 0 = unlimited. Faults that run out are "aborted".
+    long backtrackLimit = 0;
+    long timeLimitMs = 0;
+    // If > 1, aborted faults get a second pass with both limits
+    // multiplied by this factor
+    int retryScale = 0;
+
+    // Learn global implications once per circuit and prune the search
+    // with them (see LearnedImplications). Learning stops after
+    // learnTimeLimitMs (0 = no limit) and keeps what it has so far.
+    bool staticLearning = false;
+    long learnTimeLimitMs = 10000;
+
+    bool quiet = false;    // No console line per fault
+    bool progress = false; // Progress and ETA line on stderr
+
+    // Dynamic compaction: after each new test, target later undetected
+    // faults with the test's PIs fixed, to fill in its X positions.
+    // Runs single-threaded and implies fault dropping.
+    bool dynamicCompaction = false;
+    long secondaryBacktrackLimit = 64; // Per secondary fault
+    int secondaryTargets = 1000;       // Secondary faults tried per test
+};
+
+// Outcome of one fault, as written to the output file
+struct FaultResult {
+    enum class Status { TEST_FOUND, NONE_FOUND, ABORTED, ERROR };
+    Status status = Status::NONE_FOUND;
+    std::string vector;   // One character per PI when a test was found
+    std::string errorMsg; // Set for Status::ERROR
+    long backtracks = 0;
+    long pruned = 0;      // Search nodes cut by the X-path check
+    long learnedPruned = 0;       // ...and by learned implications
+    bool ruledOutByLearning = false; // Untestable without any search
+    SearchStats stats;    // Filled in PODEM_STATS builds
+};
+
+// Runs PODEM over a fault list. Workers solve faults in any order on
+// their own SimState; results are always written in fault-file order,
+// so the output is identical for any thread count.
+class AtpgRunner {
+public:
+    AtpgRunner(const Netlist& n, const AtpgOptions& opts);
+    ~AtpgRunner();
+
+    void run(const std::vector<FaultSpec>& faults, ResultWriter& out);
+
+    // Gets one row per fault written, in output order
+    void setStatsReport(StatsReport* report) { statsReport = report; }
+
+    // With staticLearning, uses 'table' (learned for this netlist) instead
+    // of learning again, e.g. across runs on one circuit
+    void setLearnedImplications(const LearnedImplications* table) { learned = table; }
+    // The table in use, once run() has started; nullptr without learning
+    const LearnedImplications* getLearnedImplications() const { return learned; }
+
+    // Summed over every fault PODEM ran on
+    long getTotalBacktracks() const { return totalBacktracks; }
+    long getTotalPruned() const { return totalPruned; }
+    long getTotalLearnedPruned() const { return totalLearnedPruned; }
+    // Faults that learned implications proved untestable before any search
+    size_t getRuledOutCount() const { return ruledOutCount; }
+    // Faults still aborted after the retry pass, if any
+    size_t getAbortedCount() const;
+
+    // Vectors PODEM produced that went to the output (not counting
+    // repeats for faults dropped onto an earlier vector)
+    size_t getPatternCount() const { return patternCount; }
+
+private:
+    // One pass over the given fault indices (ascending), with the
+    // budget multiplied by 'scale'
+    void runSequential(const std::vector<FaultSpec>& faults, const std::vector<size_t>& order,
+                       int scale, ResultWriter& out);
+    void runParallel(const std::vector<FaultSpec>& faults, const std::vector<size_t>& order,
+                     int scale, ResultWriter& out);
+    FaultResult solveFault(SimState& state, const std::vector<FaultSpec>& faults, size_t f, long backtrackLimit,
+                           long timeLimitMs, const std::string& fixedCube = std::string()) const;
+
+    // Dynamic compaction: grows a fresh test cube with secondary faults
+    void extendCube(SimState& state, const std::vector<FaultSpec>& faults, size_t f, FaultResult& result);
+
+    // Writes one result and, with fault dropping, marks the later faults
+    // its vector detects. Must be called in fault-file order within a pass.
+    void emitResult(const std::vector<FaultSpec>& faults, size_t f,
+                    const FaultResult& result, ResultWriter& out);
+    void writeLine(size_t f, const std::string& line, ResultWriter& out);
+    void reportProgress(bool done);
+
+    // Whether fault f was already detected by an earlier vector
+    bool isCovered(size_t f) const;
+
+    const Netlist& netlist;
+    AtpgOptions options;
+
+    // Netlist id of each fault's gate (-1 if unknown), resolved once per run
+    std::vector<int> faultSites;
+    std::vector<FaultType> faultTypes;
+    long totalBacktracks = 0;
+    long totalPruned = 0;
+    long totalLearnedPruned = 0;
+    size_t ruledOutCount = 0;
+    size_t patternCount = 0;
+
+    std::unique_ptr<LearnedImplications> ownLearned;
+    const LearnedImplications* learned = nullptr;
+
+    // Index of the covering fault, -1 if none. Only the writer stores;
+    // workers read it to skip faults that no longer need PODEM.
+    std::vector<std::atomic<int>> coveredBy;
+    std::vector<std::string> vectorLines;  // Vectors kept for covered faults
+    std::unique_ptr<FaultSimulator> dropSimulator;
+
+    // Faults waiting for the retry pass. Their output line isn't final
+    // yet, so with retries every line is held until the end.
+    std::vector<char> aborted;
+    bool deferOutput = false;
+    std::vector<std::string> deferredLines;
+
+    StatsReport* statsReport = nullptr;
+    int pass = 0;
+
+    // Progress through the current pass
+    size_t progressDone = 0;
+    size_t progressTotal = 0;
+    std::chrono::steady_clock::time_point progressStart;
+    std::chrono::steady_clock::time_point progressShown;
+};
+
+#endif // ATPG_RUNNER_H
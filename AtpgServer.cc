@@ -0,0 +1,284 @@
+#include "AtpgServer.h"
+#include "NetlistLoader.h"
+#include "ResultWriter.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Stream buffer over a connected socket, so a session reads and writes
+// it like std::cin and std::cout
+class FdStreamBuf : public std::streambuf {
+public:
+    explicit FdStreamBuf(int f) : fd(f) {
+        setg(inBuf, inBuf, inBuf);
+        setp(outBuf, outBuf + sizeof(outBuf));
+    }
+
+protected:
+    int_type underflow() override {
+        ssize_t n;
+        do {
+            n = ::read(fd, inBuf, sizeof(inBuf));
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) {
+            return traits_type::eof();
+        }
+        setg(inBuf, inBuf, inBuf + n);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    int_type overflow(int_type c) override {
+        if (!writeOut()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override { return writeOut() ? 0 : -1; }
+
+private:
+    bool writeOut() {
+        const char* p = pbase();
+        while (p < pptr()) {
+            ssize_t n = ::write(fd, p, pptr() - p);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            p += n;
+        }
+        setp(outBuf, outBuf + sizeof(outBuf));
+        return true;
+    }
+
+    int fd;
+    char inBuf[4096];
+    char outBuf[4096];
+};
+
+} // namespace
+
+AtpgServer::AtpgServer(const AtpgOptions& opts, bool legacy) : options(opts), legacyParser(legacy) {
+    options.quiet = true;
+    options.progress = false;
+}
+
+bool AtpgServer::load(const std::string& name, const std::string& benchFile, const std::string& cacheFile,
+                      std::string& error) {
+    NetlistLoader loader(std::cerr, std::cerr);
+    loader.setLegacyParser(legacyParser);
+    loader.setCacheFile(cacheFile);
+    Entry entry;
+    entry.netlist = loader.load(benchFile);
+    if (!entry.netlist) {
+        error = loader.getError();
+        return false;
+    }
+    if (options.staticLearning) {
+        entry.learned = LearnedImplications::learn(*entry.netlist, options.learnTimeLimitMs);
+        std::cerr << "Learned " << entry.learned->getCount() << " implications for " << name << " in "
+                  << entry.learned->getLearnMs() << " ms";
+        if (!entry.learned->isComplete()) {
+            std::cerr << " (time limit hit after " << entry.learned->getLearnedGateCount() << " of "
+                      << entry.learned->getTotalGateCount() << " gates)";
+        }
+        std::cerr << std::endl;
+    }
+    std::lock_guard<std::mutex> lock(circuitsMutex);
+    circuits[name] = std::move(entry);
+    return true;
+}
+
+AtpgServer::Entry AtpgServer::find(const std::string& name) {
+    std::lock_guard<std::mutex> lock(circuitsMutex);
+    auto it = circuits.find(name);
+    return it == circuits.end() ? Entry() : it->second;
+}
+
+void AtpgServer::serve(std::istream& in, std::ostream& out) {
+    std::string line;
+    while (out && std::getline(in, line)) {
+        std::istringstream request(line);
+        std::string command;
+        if (!(request >> command) || command[0] == '#') {
+            continue;
+        }
+
+        if (command == "load") {
+            std::string name, benchFile, cacheFile, error;
+            if (!(request >> name >> benchFile)) {
+                out << "error usage: load <name> <bench_file> [cache_file]" << std::endl;
+                continue;
+            }
+            request >> cacheFile;
+            Entry loaded;
+            if (load(name, benchFile, cacheFile, error) && (loaded = find(name)).netlist) {
+                out << "ok " << name << " " << loaded.netlist->getGateCount() << " gates" << std::endl;
+            } else {
+                out << "error " << error << std::endl;
+            }
+        } else if (command == "unload") {
+            std::string name;
+            request >> name;
+            std::lock_guard<std::mutex> lock(circuitsMutex);
+            if (circuits.erase(name)) {
+                out << "ok " << name << std::endl;
+            } else {
+                out << "error unknown circuit " << name << std::endl;
+            }
+        } else if (command == "list") {
+            std::lock_guard<std::mutex> lock(circuitsMutex);
+            for (const auto& entry : circuits) {
+                const Netlist& netlist = *entry.second.netlist;
+                out << "circuit " << entry.first << " " << netlist.getGateCount() << " gates "
+                    << netlist.getPIs().size() << " inputs " << netlist.getPOs().size() << " outputs\n";
+            }
+            out << "end" << std::endl;
+        } else if (command == "atpg") {
+            std::string name;
+            request >> name;
+            runAtpg(name, request, in, out);
+        } else if (command == "quit") {
+            return;
+        } else if (command == "shutdown") {
+            out << "ok shutting down" << std::endl;
+            requestShutdown();
+            return;
+        } else {
+            out << "error unknown command " << command << std::endl;
+        }
+    }
+}
+
+void AtpgServer::runAtpg(const std::string& name, std::istream& request, std::istream& in, std::ostream& out) {
+    // Faults come inline, or as the contents of a fault file on the
+    // following lines, up to a line "end"
+    std::string faultText;
+    std::getline(request, faultText);
+    if (faultText.find_first_not_of(" \t\r") == std::string::npos) {
+        std::string line, word;
+        while (std::getline(in, line) && !(std::istringstream(line) >> word && word == "end")) {
+            faultText += line;
+            faultText += '\n';
+        }
+    }
+    std::istringstream faultStream(faultText);
+    std::vector<FaultSpec> faults;
+    std::string gateName;
+    int value;
+    while (faultStream >> gateName) {
+        if (!(faultStream >> value)) {
+            out << "error fault " << gateName << " has no stuck-at value" << std::endl;
+            return;
+        }
+        faults.push_back({gateName, value});
+    }
+
+    Entry circuit = find(name);
+    if (!circuit.netlist) {
+        out << "error unknown circuit " << name << std::endl;
+        return;
+    }
+    ResultWriter writer(out);
+    writer.setLineFlush(true);
+    AtpgRunner runner(*circuit.netlist, options);
+    runner.setLearnedImplications(circuit.learned.get());
+    runner.run(faults, writer);
+    out << "end" << std::endl;
+}
+
+void AtpgServer::requestShutdown() {
+    stopping = true;
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    // Wakes the accept() in listen(); idle sessions see end of input,
+    // running requests still finish and send their results
+    if (listenFd >= 0) {
+        ::shutdown(listenFd, SHUT_RDWR);
+    }
+    for (int fd : sessionFds) {
+        ::shutdown(fd, SHUT_RD);
+    }
+}
+
+bool AtpgServer::listen(const std::string& socketPath) {
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Socket path too long: " << socketPath << std::endl;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    ::unlink(socketPath.c_str()); // A socket left behind by an earlier server
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, 16) < 0) {
+        std::cerr << "Error: Cannot listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+    // A client that disconnects mid-request must not kill the server
+    std::signal(SIGPIPE, SIG_IGN);
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        listenFd = fd;
+    }
+    std::cerr << "Listening on " << socketPath << std::endl;
+
+    while (!stopping) {
+        int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (!stopping) {
+                std::cerr << "Error: accept failed: " << std::strerror(errno) << std::endl;
+            }
+            break;
+        }
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        if (stopping) {
+            ::close(client);
+            break;
+        }
+        sessionFds.insert(client);
+        std::thread([this, client] {
+            {
+                FdStreamBuf buffer(client);
+                std::istream in(&buffer);
+                std::ostream out(&buffer);
+                serve(in, out);
+                out.flush();
+            }
+            std::lock_guard<std::mutex> lock(sessionsMutex);
+            sessionFds.erase(client);
+            ::close(client);
+            sessionsDone.notify_all();
+        }).detach();
+    }
+
+    std::unique_lock<std::mutex> lock(sessionsMutex);
+    ::close(fd);
+    listenFd = -1;
+    ::unlink(socketPath.c_str());
+    sessionsDone.wait(lock, [this] { return sessionFds.empty(); });
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef ATPG_SERVER_H
+#define ATPG_SERVER_H
+
+#include "AtpgRunner.h"
+#include "Netlist.h"
+#include "StaticLearning.h"
+#include <atomic>
+#include <condition_variable>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+
+// Long-running ATPG service (--serve). Circuits are loaded once, under a
+// name, and stay compiled in memory; each request then only pays for
+// PODEM. Requests use a line protocol:
+//
+//   load <name> <bench_file> [cache_file]  ->  ok <name> <gates> gates | error <message>
+//   unload <name>                          ->  ok <name> | error <message>
+//   list                                   ->  circuit <name> <gates> gates ..., end
+//   atpg <name> [<gate> <value> ...]       ->  one result line per fault, end
+//   quit                                   (closes this session)
+//   shutdown                               (stops the server)
+//
+// Without inline faults, "atpg" reads the contents of a fault file
+// ("<gate> <value>" pairs) up to a line "end". Result lines are the output-file lines, in fault order,
+// and each one is sent as soon as it is final.
+//
+// Sessions run concurrently (one thread per socket connection) and share
+// the loaded circuits. With static learning, a circuit is learned once
+// when it is loaded. A request keeps its circuit alive, so unloading or
+// reloading one never disturbs a request already running on it.
+class AtpgServer {
+public:
+    // 'options' applies to every request. Console lines are always off.
+    AtpgServer(const AtpgOptions& options, bool legacyParser);
+
+    // Loads (or replaces) a circuit; returns false with 'error' set
+    bool load(const std::string& name, const std::string& benchFile, const std::string& cacheFile,
+              std::string& error);
+
+    // Serves one session, until "quit", "shutdown" or the end of 'in'
+    void serve(std::istream& in, std::ostream& out);
+
+    // Accepts sessions on a Unix domain socket until a "shutdown" request,
+    // then waits for the open sessions to finish. Returns false if the
+    // socket cannot be set up.
+    bool listen(const std::string& socketPath);
+
+private:
+    // A loaded circuit, with its learned implications under --learn
+    struct Entry {
+        std::shared_ptr<const Netlist> netlist;
+        std::shared_ptr<const LearnedImplications> learned;
+    };
+
+    Entry find(const std::string& name);
+    void runAtpg(const std::string& name, std::istream& request, std::istream& in, std::ostream& out);
+    void requestShutdown();
+
+    AtpgOptions options;
+    bool legacyParser;
+
+    std::mutex circuitsMutex;
+    std::map<std::string, Entry> circuits;
+
+    std::atomic<bool> stopping{false};
+    int listenFd = -1;
+    std::mutex sessionsMutex;
+    std::condition_variable sessionsDone;
+    std::set<int> sessionFds; // Open session sockets
+};
+
+#endif // ATPG_SERVER_H
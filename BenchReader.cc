@@ -0,0 +1,254 @@
+#include "BenchReader.h"
+#include "MappedFile.h"
+#include <cctype>
+#include <unordered_map>
+
+namespace {
+
+bool isNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '[' || c == ']';
+}
+
+bool equalsIgnoreCase(std::string_view a, const char* b) {
+    size_t i = 0;
+    for (; i < a.size() && b[i]; ++i) {
+        if (std::toupper(static_cast<unsigned char>(a[i])) != b[i]) {
+            return false;
+        }
+    }
+    return i == a.size() && !b[i];
+}
+
+bool lookupGateType(std::string_view word, GateType& type) {
+    static const struct { const char* name; GateType type; } table[] = {
+        {"AND", GateType::AND},   {"OR", GateType::OR},     {"NOT", GateType::NOT},
+        {"NAND", GateType::NAND}, {"NOR", GateType::NOR},   {"XOR", GateType::XOR},
+        {"XNOR", GateType::XNOR}, {"BUFF", GateType::BUFF}, {"BUF", GateType::BUFF},
+    };
+    for (const auto& entry : table) {
+        if (equalsIgnoreCase(word, entry.name)) {
+            type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool BenchReader::read(const std::string& filePath, Circuit& circuit) {
+    path = filePath;
+    error.clear();
+    undriven.clear();
+    statements.clear();
+    fanins.clear();
+
+    MappedFile file(filePath);
+    if (!file.isOpen()) {
+        error = "Cannot open bench file " + filePath;
+        return false;
+    }
+    return parse(file.text()) && build(circuit);
+}
+
+// --- Tokenizer ---
+
+BenchReader::Token BenchReader::next() {
+    while (pos < end) {
+        char c = *pos;
+        if (c == '\n') {
+            line++;
+            pos++;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            pos++;
+        } else if (c == '#') {
+            while (pos < end && *pos != '\n') {
+                pos++;
+            }
+        } else {
+            break;
+        }
+    }
+    if (pos == end) {
+        return {TokenKind::END, std::string_view(), line};
+    }
+
+    const char* start = pos;
+    switch (*pos) {
+        case '(': pos++; return {TokenKind::LPAREN, std::string_view(start, 1), line};
+        case ')': pos++; return {TokenKind::RPAREN, std::string_view(start, 1), line};
+        case '=': pos++; return {TokenKind::EQUALS, std::string_view(start, 1), line};
+        case ',': pos++; return {TokenKind::COMMA, std::string_view(start, 1), line};
+        default: break;
+    }
+    while (pos < end && isNameChar(*pos)) {
+        pos++;
+    }
+    if (pos == start) {
+        pos++; // Hand the bad character back as a one-character name
+        return {TokenKind::END, std::string_view(start, 1), line};
+    }
+    return {TokenKind::NAME, std::string_view(start, pos - start), line};
+}
+
+bool BenchReader::expect(TokenKind kind, const char* what, Token& tok) {
+    tok = next();
+    if (tok.kind == kind) {
+        return true;
+    }
+    if (tok.kind == TokenKind::END && !tok.text.empty()) {
+        return fail(tok.line, "unexpected character '" + std::string(tok.text) + "'");
+    }
+    std::string found = tok.text.empty() ? "end of file" : "'" + std::string(tok.text) + "'";
+    return fail(tok.line, std::string("expected ") + what + ", found " + found);
+}
+
+bool BenchReader::fail(int errorLine, const std::string& message) {
+    error = path + ":" + std::to_string(errorLine) + ": " + message;
+    return false;
+}
+
+// --- Pass 1: statements ---
+
+bool BenchReader::parse(std::string_view text) {
+    pos = text.data();
+    end = text.data() + text.size();
+    line = 1;
+
+    Token tok;
+    while (true) {
+        Token first = next();
+        if (first.kind == TokenKind::END) {
+            if (!first.text.empty()) {
+                return fail(first.line, "unexpected character '" + std::string(first.text) + "'");
+            }
+            return true;
+        }
+        if (first.kind != TokenKind::NAME) {
+            return fail(first.line, "expected a statement, found '" + std::string(first.text) + "'");
+        }
+
+        Statement st{Statement::Kind::ASSIGN, first.text, GateType::BUFF, fanins.size(), 0, first.line};
+        bool isInput = equalsIgnoreCase(first.text, "INPUT");
+        bool isOutput = equalsIgnoreCase(first.text, "OUTPUT");
+        Token after = next();
+
+        if ((isInput || isOutput) && after.kind == TokenKind::LPAREN) {
+            // INPUT(name) / OUTPUT(name)
+            if (!expect(TokenKind::NAME, "a net name", tok)) {
+                return false;
+            }
+            st.kind = isInput ? Statement::Kind::INPUT : Statement::Kind::OUTPUT;
+            st.name = tok.text;
+            if (!expect(TokenKind::RPAREN, "')'", tok)) {
+                return false;
+            }
+        } else if (after.kind == TokenKind::EQUALS) {
+            // name = TYPE(in1, in2, ...)
+            if (!expect(TokenKind::NAME, "a gate type", tok)) {
+                return false;
+            }
+            if (!lookupGateType(tok.text, st.type)) {
+                return fail(tok.line, "unknown gate type '" + std::string(tok.text) + "'");
+            }
+            if (!expect(TokenKind::LPAREN, "'('", tok)) {
+                return false;
+            }
+            do {
+                if (!expect(TokenKind::NAME, "an input name", tok)) {
+                    return false;
+                }
+                fanins.push_back(tok.text);
+                tok = next();
+            } while (tok.kind == TokenKind::COMMA);
+            if (tok.kind != TokenKind::RPAREN) {
+                std::string found = tok.text.empty() ? "end of file" : "'" + std::string(tok.text) + "'";
+                return fail(tok.line, "expected ',' or ')', found " + found);
+            }
+            st.faninCount = fanins.size() - st.firstFanin;
+        } else {
+            std::string found = after.text.empty() ? "end of file" : "'" + std::string(after.text) + "'";
+            return fail(after.line, "expected '=' after '" + std::string(first.text) + "', found " + found);
+        }
+        statements.push_back(st);
+    }
+}
+
+// --- Pass 2: gates and connections ---
+
+bool BenchReader::build(Circuit& circuit) {
+    struct Net {
+        int defLine = 0; // Line of the INPUT or assignment, 0 if none
+        GateType type = GateType::BUFF;
+        int fanins = 0;
+        int fanouts = 0;
+        Gate* gate = nullptr;
+    };
+    std::unordered_map<std::string_view, Net> nets;
+    nets.reserve(statements.size() * 2);
+
+    // Resolve every name once; fanin lookups are kept for the later sweeps
+    std::vector<Net*> faninNets(fanins.size());
+    for (const Statement& st : statements) {
+        Net& net = nets[st.name];
+        if (st.kind == Statement::Kind::OUTPUT) {
+            net.fanouts++; // Its PO gate
+            continue;
+        }
+        if (net.defLine != 0) {
+            return fail(st.line, "'" + std::string(st.name) + "' is already defined on line " +
+                                 std::to_string(net.defLine));
+        }
+        net.defLine = st.line;
+        net.type = (st.kind == Statement::Kind::INPUT) ? GateType::PI : st.type;
+        net.fanins = st.faninCount;
+        for (size_t i = st.firstFanin; i < st.firstFanin + st.faninCount; ++i) {
+            faninNets[i] = &nets[fanins[i]];
+            faninNets[i]->fanouts++;
+        }
+    }
+
+    // Everything is counted now, so the circuit's arena can be sized once
+    size_t nameBytes = 0;
+    for (const auto& entry : nets) {
+        nameBytes += entry.first.size();
+    }
+    circuit.reserve(nets.size(), fanins.size(), nameBytes);
+
+    // Gates are created in the yacc parser's order: each defined net at its
+    // statement, each undriven net at its first use
+    std::vector<Net*> outputNets(statements.size());
+    auto create = [&](std::string_view name, Net& net) {
+        if (!net.gate) {
+            net.gate = circuit.addGate(name, net.type);
+            net.gate->reserveInputs(net.fanins);
+            net.gate->reserveOutputs(net.fanouts);
+        }
+    };
+    for (size_t s = 0; s < statements.size(); ++s) {
+        const Statement& st = statements[s];
+        if (st.kind == Statement::Kind::OUTPUT) {
+            circuit.addOutput(st.name);
+            continue;
+        }
+        outputNets[s] = &nets[st.name];
+        create(st.name, *outputNets[s]);
+        for (size_t i = st.firstFanin; i < st.firstFanin + st.faninCount; ++i) {
+            Net& net = *faninNets[i];
+            if (net.defLine == 0 && !net.gate) {
+                undriven.emplace_back(fanins[i]);
+                create(fanins[i], net);
+            }
+        }
+    }
+
+    // Connections in statement order keep the fanout order (and so the
+    // fanout branch names) the same as before
+    for (size_t s = 0; s < statements.size(); ++s) {
+        const Statement& st = statements[s];
+        for (size_t i = st.firstFanin; i < st.firstFanin + st.faninCount; ++i) {
+            circuit.connect(faninNets[i]->gate, outputNets[s]->gate);
+        }
+    }
+    return true;
+}
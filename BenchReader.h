@@ -0,0 +1,67 @@
+#ifndef BENCH_READER_H
+#define BENCH_READER_H
+
+#include "Circuit.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Hand-written .bench reader. The file is memory-mapped and tokenized in
+// place: names are string_views into the mapping until a gate is created,
+// so each net costs one string allocation (its Gate name).
+//
+// Accepts the same syntax as the Flex/Bison front end (upper- or lowercase
+// keywords, '#' comments, statements may span lines). Nets may be used
+// before the line that defines them; they get their real type, which the
+// yacc parser could not do (it left them as BUFF). Gates are created and
+// connected in the same order as the yacc parser, so for files without
+// forward references the resulting Circuit is identical.
+class BenchReader {
+public:
+    // Parses 'path' into an empty 'circuit' (before buildSimulationList()).
+    // On failure returns false and getError() holds "path:line: message".
+    bool read(const std::string& path, Circuit& circuit);
+    const std::string& getError() const { return error; }
+
+    // Nets that are used but never defined; they become input-less BUFFs
+    const std::vector<std::string>& getUndrivenNets() const { return undriven; }
+
+private:
+    enum class TokenKind { NAME, LPAREN, RPAREN, EQUALS, COMMA, END };
+    struct Token {
+        TokenKind kind;
+        std::string_view text;
+        int line;
+    };
+
+    // One parsed statement; fanins are a slice of 'fanins'
+    struct Statement {
+        enum class Kind { INPUT, OUTPUT, ASSIGN } kind;
+        std::string_view name;
+        GateType type;
+        size_t firstFanin;
+        size_t faninCount;
+        int line;
+    };
+
+    bool parse(std::string_view text);
+    bool build(Circuit& circuit);
+
+    Token next();
+    bool expect(TokenKind kind, const char* what, Token& tok);
+    bool fail(int line, const std::string& message);
+
+    std::string path;
+    std::string error;
+    std::vector<std::string> undriven;
+
+    // Tokenizer cursor
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    int line = 1;
+
+    std::vector<Statement> statements;
+    std::vector<std::string_view> fanins;
+};
+
+#endif // BENCH_READER_H
@@ -1,51 +1,58 @@
 #include "Circuit.h"
 #include "LogicGates.h"
 #include <stdexcept>
+#include <new>
 #include <queue>
-#include <set>
-#include <sstream> // For fanout naming
+
+Circuit::Circuit() : arena(std::make_unique<std::pmr::monotonic_buffer_resource>()) {}
+
+void Circuit::reserve(size_t gateCount, size_t connectionCount, size_t nameBytes) {
+    if (!allGates.empty()) {
+        return;
+    }
+    // Every gate class has the same layout; names go to the NameTable
+    size_t bytes = gateCount * sizeof(BuffGate) + 2 * connectionCount * sizeof(Gate*);
+    arena = std::make_unique<std::pmr::monotonic_buffer_resource>(bytes);
+    allGates.reserve(gateCount);
+    names.reserve(gateCount, nameBytes);
+}
+
+// Constructs a gate of class T in the arena
+template <class T> Gate* Circuit::makeGate() {
+    void* memory = arena->allocate(sizeof(T), alignof(T));
+    return new (memory) T(arena.get());
+}
 
 // Private helper to create gate objects
-Gate* Circuit::createGate(const std::string& name, GateType type) {
-    std::unique_ptr<Gate> newGate;
-    if (type == GateType::PI) {
-        newGate = std::make_unique<PiGate>(name);
-    } else if (type == GateType::PO) {
-        newGate = std::make_unique<PoGate>(name);
-    } else if (type == GateType::AND) {
-        newGate = std::make_unique<AndGate>(name);
-    } else if (type == GateType::OR) {
-        newGate = std::make_unique<OrGate>(name);
-    } else if (type == GateType::NOT) {
-        newGate = std::make_unique<NotGate>(name);
-    } else if (type == GateType::NAND) {
-        newGate = std::make_unique<NandGate>(name);
-    } else if (type == GateType::NOR) {
-        newGate = std::make_unique<NorGate>(name);
-    } else if (type == GateType::XOR) {
-        newGate = std::make_unique<XorGate>(name);
-    } else if (type == GateType::XNOR) {
-        newGate = std::make_unique<XnorGate>(name);
-    } else if (type == GateType::BUFF) {
-        newGate = std::make_unique<BuffGate>(name);
-    } else if (type == GateType::FANOUT) { // <-- ADDED
-        newGate = std::make_unique<FanoutGate>(name);
-    } else {
-        throw std::runtime_error("Unknown gate type");
+Gate* Circuit::createGate(GateType type) {
+    switch (type) {
+        case GateType::PI:     return makeGate<PiGate>();
+        case GateType::PO:     return makeGate<PoGate>();
+        case GateType::AND:    return makeGate<AndGate>();
+        case GateType::OR:     return makeGate<OrGate>();
+        case GateType::NOT:    return makeGate<NotGate>();
+        case GateType::NAND:   return makeGate<NandGate>();
+        case GateType::NOR:    return makeGate<NorGate>();
+        case GateType::XOR:    return makeGate<XorGate>();
+        case GateType::XNOR:   return makeGate<XnorGate>();
+        case GateType::BUFF:   return makeGate<BuffGate>();
+        case GateType::FANOUT: return makeGate<FanoutGate>();
+        default: throw std::runtime_error("Unknown gate type");
     }
-    return newGate.release(); // Release ownership to the caller
 }
 
 
-Gate* Circuit::addGate(const std::string& name, GateType type) {
-    if (gateMap.count(name)) {
-        return gateMap[name];
+Gate* Circuit::addGate(std::string_view name, GateType type) {
+    int existing = names.find(name);
+    if (existing >= 0) {
+        return allGates[existing]; // Already exists
     }
     
-    Gate* newGatePtr = createGate(name, type);
+    // Interned only once the gate exists, so name ids stay gate ids
+    Gate* newGatePtr = createGate(type);
     
-    allGates.emplace_back(newGatePtr); // Vector takes ownership
-    gateMap[name] = newGatePtr;        // Map gets raw pointer
+    newGatePtr->setId(names.intern(name));
+    allGates.push_back(newGatePtr);
     
     if (type == GateType::PI) {
         PIs.push_back(newGatePtr);
@@ -56,11 +63,11 @@ Gate* Circuit::addGate(const std::string& name, GateType type) {
     return newGatePtr;
 }
 
-void Circuit::addOutput(const std::string& name) {
-    poNames.push_back(name);
+void Circuit::addOutput(std::string_view name) {
+    poNames.emplace_back(name);
 }
 
-void Circuit::connect(const std::string& sourceName, const std::string& destName) {
+void Circuit::connect(std::string_view sourceName, std::string_view destName) {
     Gate* source = getGate(sourceName);
     Gate* dest = getGate(destName);
     
@@ -73,72 +80,42 @@ void Circuit::connect(const std::string& sourceName, const std::string& destName
         dest = addGate(destName, GateType::BUFF);
     }
     
-    dest->addInput(source);
-    source->addOutput(dest);
-}
-
-Gate* Circuit::getGate(const std::string& name) {
-    if (gateMap.count(name)) {
-        return gateMap[name];
-    }
-    return nullptr;
-}
-
-bool Circuit::isPO(Gate* g) {
-    for (auto po : POs) {
-        if (po == g) return true;
-    }
-    return false;
+    connect(source, dest);
 }
 
-void Circuit::clearAllValues() {
-    for (auto& gate : allGates) {
-        if (gate->getType() != GateType::PI) {
-            gate->setValue(LogicValue::UNSET);
-        } else {
-            gate->setValue(LogicValue::X);
-        }
-    }
+void Circuit::connect(Gate* source, Gate* dest) {
+    dest->addInput(source);
+    source->addOutput(dest);
 }
 
-void Circuit::setAllFaults(FaultType f) {
-    for (auto& gate : allGates) {
-        gate->setFault(f);
-    }
-}
-
-// NEW: Runs a full simulation using the topologically sorted list
-void Circuit::runFullSimulation() {
-    for (Gate* g : simulationList) {
-        LogicValue val = g->evaluate();
-        g->setValue(val);
-    }
+Gate* Circuit::getGate(std::string_view name) {
+    // find() rather than intern(), so concurrent lookups stay read-only
+    int id = names.find(name);
+    return (id >= 0) ? allGates[id] : nullptr;
 }
 
 // MODIFIED: This function now also creates fanout gates
 void Circuit::buildSimulationList() {
     // --- FIX FOR PROBLEM 2: Add Fanout Gates ---
     // This logic is from the original project's ClassCircuit.cc
-    std::vector<Gate*> originalGates;
-    for(auto& g_ptr : allGates) {
-        originalGates.push_back(g_ptr.get());
-    }
-
-    for (Gate* g : originalGates) {
+    // Fanout gates are appended to allGates as we go; only the original
+    // gates are visited
+    size_t originalCount = allGates.size();
+    for (size_t gi = 0; gi < originalCount; ++gi) {
+        Gate* g = allGates[gi];
         if (g->getOutputs().size() > 1) {
             // This is a fanout stem
-            std::vector<Gate*> originalOutputs = g->getOutputs();
+            std::vector<Gate*> originalOutputs(g->getOutputs().begin(), g->getOutputs().end());
             g->clearOutputs(); // Disconnect stem from branches
 
             for (int i = 0; i < originalOutputs.size(); ++i) {
                 Gate* branch = originalOutputs[i];
                 
                 // Create a new fanout gate name (e.g., "A_0", "A_1")
-                std::stringstream fanoutName;
-                fanoutName << g->getName() << "_" << i;
+                std::string fanoutName = std::string(getName(g)) + "_" + std::to_string(i);
                 
                 // Create the new fanout gate
-                Gate* fanoutGate = addGate(fanoutName.str(), GateType::FANOUT);
+                Gate* fanoutGate = addGate(fanoutName, GateType::FANOUT);
                 
                 // Connect g -> fanoutGate -> branch
                 g->addOutput(fanoutGate);
@@ -154,34 +131,43 @@ void Circuit::buildSimulationList() {
     for (const std::string& name : poNames) {
         Gate* gate = getGate(name);
         if (gate) {
-            std::string poName = name + "_PO";
-            Gate* poGate = addGate(poName, GateType::PO);
-            connect(name, poName);
+            Gate* poGate = addGate(name + "_PO", GateType::PO);
+            connect(gate, poGate);
         }
     }
 
     // Now, do a topological sort (Kahn's algorithm)
     simulationList.clear();
-    std::map<Gate*, int> inDegree;
+    std::vector<int> inDegree(allGates.size()); // By gate id
     std::queue<Gate*> q;
 
-    for (auto& gate : allGates) {
-        inDegree[gate.get()] = gate->getInputs().size();
-        if (inDegree[gate.get()] == 0) {
-            q.push(gate.get()); 
+    for (Gate* gate : allGates) {
+        inDegree[gate->getId()] = gate->getInputs().size();
+        if (inDegree[gate->getId()] == 0) {
+            q.push(gate); 
         }
     }
 
+    int maxLevel = 0;
     while (!q.empty()) {
         Gate* g = q.front();
         q.pop();
         simulationList.push_back(g);
 
+        // Level = longest path from any source, used to order events
+        int level = 0;
+        for (Gate* input : g->getInputs()) {
+            level = std::max(level, input->getLevel() + 1);
+        }
+        g->setLevel(level);
+        maxLevel = std::max(maxLevel, level);
+
         for (Gate* output : g->getOutputs()) {
-            inDegree[output]--;
-            if (inDegree[output] == 0) {
+            if (--inDegree[output->getId()] == 0) {
                 q.push(output);
             }
         }
     }
-}
\ No newline at end of file
+
+    levelCount = maxLevel + 1;
+}
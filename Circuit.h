@@ -2,46 +2,60 @@
 #define CIRCUIT_H
 
 #include "Gate.h"
+#include "NameTable.h"
 #include <string>
+#include <string_view>
 #include <vector>
-#include <map>
-#include <memory> 
+#include <memory>
+#include <memory_resource>
 
 class Circuit {
 public:
-    Circuit() = default;
+    Circuit();
+    // Gates live in 'arena', which frees them all in one shot
+    ~Circuit() = default;
+    Circuit(const Circuit&) = delete;
+    Circuit& operator=(const Circuit&) = delete;
+
+    // Sizes the arena and tables for a netlist of about this many gates,
+    // fanin connections and name characters. Only takes effect before the
+    // first gate is added; the fanout gates of buildSimulationList() come
+    // out of further, geometrically growing arena blocks.
+    void reserve(size_t gateCount, size_t connectionCount, size_t nameBytes);
 
     // --- Building Functions ---
-    Gate* addGate(const std::string& name, GateType type);
-    void addOutput(const std::string& name);
-    void connect(const std::string& sourceName, const std::string& destName);
+    Gate* addGate(std::string_view name, GateType type);
+    void addOutput(std::string_view name);
+    void connect(std::string_view sourceName, std::string_view destName);
+    void connect(Gate* source, Gate* dest); // Both must belong to this circuit
 
     // --- Accessors ---
-    Gate* getGate(const std::string& name);
+    Gate* getGate(std::string_view name);
+    // Valid until the next gate is added
+    std::string_view getName(const Gate* g) const { return names.getName(g->getId()); }
     std::vector<Gate*>& getPIs() { return PIs; }
     std::vector<Gate*>& getPOs() { return POs; }
-    std::vector<std::unique_ptr<Gate>>& getAllGates() { return allGates; }
-    bool isPO(Gate* g);
-
-    // --- Simulation & State ---
-    void clearAllValues();
-    void setAllFaults(FaultType f);
+    const std::vector<Gate*>& getAllGates() const { return allGates; }
+    bool isPO(const Gate* g) const { return g->getType() == GateType::PO; }
+    const std::vector<Gate*>& getSimulationList() const { return simulationList; }
+    int getLevelCount() const { return levelCount; }
 
     // Performs a topological sort and adds fanout gates
     void buildSimulationList();
-    
-    // Runs a full simulation
-    void runFullSimulation(); // <-- REPLACES simulateEvent
 
 private:
-    // Helper for addGate
-    Gate* createGate(const std::string& name, GateType type);
+    // Helpers for addGate
+    Gate* createGate(GateType type);
+    template <class T> Gate* makeGate();
 
-    // This vector OWNS all the gates
-    std::vector<std::unique_ptr<Gate>> allGates;
+    // Bump allocator holding every gate and its adjacency lists
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+
+    // All gates, by id (memory owned by 'arena')
+    std::vector<Gate*> allGates;
     
-    // This map provides fast lookups by name
-    std::map<std::string, Gate*> gateMap;
+    // Gate names, interned in creation order: a gate's name id is its id
+    NameTable names;
     
     // Pointers for quick access
     std::vector<Gate*> PIs;
@@ -50,6 +64,8 @@ private:
     
     // For ordered simulation
     std::vector<Gate*> simulationList;
+
+    int levelCount = 0;
 };
 
 #endif // CIRCUIT_H
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "FaultCollapser.h"
+
+FaultCollapser::FaultCollapser(const Netlist& n) : netlist(n), classCount(0) {
+    int gateCount = netlist.getGateCount();
+    classOf.resize(2 * gateCount);
+    for (int f = 0; f < 2 * gateCount; ++f) {
+        classOf[f] = f;
+    }
+
+    // 1. Equivalence: union the fault on each single-fanout input net with
+    // the output fault it is indistinguishable from. PO gates are skipped,
+    // since the simulator never injects faults on them.
+    for (int h = 0; h < netlist.getSimulationCount(); ++h) {
+        GateType type = netlist.getType(h);
+        for (int g : netlist.getInputs(h)) {
+            if (netlist.getOutputs(g).size() != 1) {
+                continue; // A stem is observable through its other branches too
+            }
+            switch (type) {
+                case GateType::AND:  unite(faultIndex(g, 0), faultIndex(h, 0)); break;
+                case GateType::NAND: unite(faultIndex(g, 0), faultIndex(h, 1)); break;
+                case GateType::OR:   unite(faultIndex(g, 1), faultIndex(h, 1)); break;
+                case GateType::NOR:  unite(faultIndex(g, 1), faultIndex(h, 0)); break;
+                case GateType::NOT:
+                    unite(faultIndex(g, 0), faultIndex(h, 1));
+                    unite(faultIndex(g, 1), faultIndex(h, 0));
+                    break;
+                case GateType::BUFF:
+                case GateType::FANOUT:
+                    unite(faultIndex(g, 0), faultIndex(h, 0));
+                    unite(faultIndex(g, 1), faultIndex(h, 1));
+                    break;
+                default:
+                    break; // XOR/XNOR inputs aren't equivalent to anything
+            }
+        }
+    }
+    for (int f = 0; f < 2 * gateCount; ++f) {
+        classOf[f] = find(f);
+        if (classOf[f] == f && isTargetable(f / 2)) {
+            classCount++;
+        }
+    }
+
+    // 2. Dominance: the output fault with the non-controlling value
+    // (AND s-a-1, NAND s-a-0, OR s-a-0, NOR s-a-1) is detected by every
+    // test for a single-fanout input stuck at the non-controlling value
+    for (int h = 0; h < netlist.getSimulationCount(); ++h) {
+        int inputValue, outputValue;
+        switch (netlist.getType(h)) {
+            case GateType::AND:  inputValue = 1; outputValue = 1; break;
+            case GateType::NAND: inputValue = 1; outputValue = 0; break;
+            case GateType::OR:   inputValue = 0; outputValue = 0; break;
+            case GateType::NOR:  inputValue = 0; outputValue = 1; break;
+            default: continue;
+        }
+        if (netlist.getInputs(h).size() < 2) {
+            continue; // Single-input gates are already fully equivalent
+        }
+        Dominance d;
+        d.dominating = getClass(h, outputValue);
+        for (int g : netlist.getInputs(h)) {
+            if (netlist.getOutputs(g).size() == 1) {
+                d.dominated.push_back(getClass(g, inputValue));
+            }
+        }
+        if (!d.dominated.empty()) {
+            dominances.push_back(std::move(d));
+        }
+    }
+}
+
+bool FaultCollapser::isTargetable(int id) const {
+    return netlist.getLevel(id) >= 0 && netlist.getType(id) != GateType::PO;
+}
+
+int FaultCollapser::find(int f) {
+    while (classOf[f] != f) {
+        classOf[f] = classOf[classOf[f]];
+        f = classOf[f];
+    }
+    return f;
+}
+
+// The root is the member declared first, so representatives are stable
+// and read naturally in a collapsed list
+void FaultCollapser::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return;
+    }
+    int rankA = netlist.getDeclarationRank(a / 2) * 2 + a % 2;
+    int rankB = netlist.getDeclarationRank(b / 2) * 2 + b % 2;
+    if (rankB < rankA) {
+        std::swap(a, b);
+    }
+    classOf[b] = a;
+}
+
+std::vector<char> FaultCollapser::selectDominating(const std::vector<char>& targeted,
+                                                   std::vector<std::vector<int>>& covering) const {
+    std::vector<char> dropped(classOf.size(), 0);
+    covering.assign(classOf.size(), {});
+
+    // Dominated classes sit in the single-fanout fanin tree of the gate,
+    // so in topological order their own fate is settled before they are
+    // relied on here
+    for (const Dominance& d : dominances) {
+        if (!targeted[d.dominating]) {
+            continue;
+        }
+        for (int c : d.dominated) {
+            if (targeted[c] && !dropped[c] && c != d.dominating) {
+                covering[d.dominating].push_back(c);
+            }
+        }
+        if (!covering[d.dominating].empty()) {
+            dropped[d.dominating] = 1;
+        }
+    }
+    return dropped;
+}
+
+int FaultCollapser::writeCollapsedList(std::ostream& out) const {
+    std::vector<char> targeted(classOf.size(), 0);
+    for (int id = 0; id < netlist.getGateCount(); ++id) {
+        if (isTargetable(id)) {
+            targeted[getClass(id, 0)] = 1;
+            targeted[getClass(id, 1)] = 1;
+        }
+    }
+    std::vector<std::vector<int>> covering;
+    std::vector<char> dropped = selectDominating(targeted, covering);
+
+    // Declaration order, as in the hand-written fault files
+    int written = 0;
+    std::vector<char> done(classOf.size(), 0);
+    for (int id : netlist.getDeclarationOrder()) {
+        if (!isTargetable(id)) {
+            continue;
+        }
+        for (int value = 0; value <= 1; ++value) {
+            int c = getClass(id, value);
+            if (done[c] || dropped[c]) {
+                continue;
+            }
+            done[c] = 1;
+            out << netlist.getName(c / 2) << "\n" << (c % 2) << "\n";
+            written++;
+        }
+    }
+    return written;
+}
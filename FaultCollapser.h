@@ -0,0 +1,58 @@
+#ifndef FAULT_COLLAPSER_H
+#define FAULT_COLLAPSER_H
+
+#include "Netlist.h"
+#include <ostream>
+#include <vector>
+
+// Structural fault collapsing over the fanout-expanded netlist.
+//
+// A fault is a stuck-at value on a gate's output net, indexed as
+// 2 * id + value. Faults are equivalent when they have the same tests;
+// local rules find most of them (an AND input s-a-0 and its output s-a-0,
+// inverter/buffer/fanout-branch chains). A fault dominates another when
+// every test for the other also detects it, e.g. an AND output s-a-1
+// over each of its input s-a-1 faults. The rules only look through nets
+// with a single fanout, which after fanout expansion is every branch.
+class FaultCollapser {
+public:
+    explicit FaultCollapser(const Netlist& n);
+
+    static int faultIndex(int id, int value) { return 2 * id + value; }
+
+    // Representative fault of the equivalence class; the member declared
+    // first in the circuit
+    int getClass(int id, int value) const { return classOf[faultIndex(id, value)]; }
+    int getClassCount() const { return classCount; }
+
+    // Given the classes being targeted (indexed by representative), marks
+    // those that can skip PODEM because they dominate some other targeted
+    // class. covering[c] lists the dominated classes whose tests should
+    // detect a dropped class c.
+    std::vector<char> selectDominating(const std::vector<char>& targeted,
+                                       std::vector<std::vector<int>>& covering) const;
+
+    // Writes the collapsed fault list (equivalence and dominance) of the
+    // whole circuit in fault-file format; returns the number of faults written
+    int writeCollapsedList(std::ostream& out) const;
+
+private:
+    int find(int f);
+    void unite(int a, int b);
+
+    const Netlist& netlist;
+    std::vector<int> classOf;
+    int classCount;
+
+    // One entry per AND/NAND/OR/NOR gate, in topological order
+    struct Dominance {
+        int dominating;             // Output fault class
+        std::vector<int> dominated; // Input fault classes
+    };
+    std::vector<Dominance> dominances;
+
+    // Whether a fault belongs in the circuit's fault universe
+    bool isTargetable(int id) const;
+};
+
+#endif // FAULT_COLLAPSER_H
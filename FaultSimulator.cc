@@ -0,0 +1,303 @@
+#include "FaultSimulator.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FAULTSIM_X86_KERNELS 1
+#endif
+
+#define KERNEL_INLINE inline __attribute__((always_inline))
+
+// --- Block types ---
+// Block<B>::type holds B words of pattern bits. The wide ones are compiler
+// vector types, so one kernel source compiles to scalar, SSE2, AVX2 or
+// AVX-512 code depending on the target of the function it is inlined into.
+template <int B> struct Block;
+template <> struct Block<1> { typedef uint64_t type; };
+template <> struct Block<2> { typedef uint64_t type __attribute__((vector_size(16))); };
+template <> struct Block<4> { typedef uint64_t type __attribute__((vector_size(32))); };
+template <> struct Block<8> { typedef uint64_t type __attribute__((vector_size(64))); };
+
+// Width-specific kernels. Everything here is forced inline so it picks up
+// the instruction set of the dispatch wrappers further down.
+struct FaultSimKernel {
+    template <int B> using W = typename Block<B>::type;
+
+    // Net values live in plain uint64_t arrays; memcpy compiles to an
+    // unaligned vector load/store
+    template <int B> static KERNEL_INLINE void load(W<B>& w, const uint64_t* p) {
+        std::memcpy(&w, p, sizeof(W<B>));
+    }
+
+    template <int B> static KERNEL_INLINE void store(uint64_t* p, const W<B>& w) {
+        std::memcpy(p, &w, sizeof(W<B>));
+    }
+
+    template <int B> static KERNEL_INLINE bool any(const W<B>& w) {
+        uint64_t words[B];
+        store<B>(words, w);
+        uint64_t all = 0;
+        for (int i = 0; i < B; ++i) {
+            all |= words[i];
+        }
+        return all != 0;
+    }
+
+    template <int B> static KERNEL_INLINE int firstSetBit(const W<B>& w) {
+        uint64_t words[B];
+        store<B>(words, w);
+        for (int i = 0; i < B; ++i) {
+            if (words[i]) {
+                return i * FaultSimulator::PATTERNS_PER_WORD + __builtin_ctzll(words[i]);
+            }
+        }
+        return -1;
+    }
+
+    template <int B> static KERNEL_INLINE const uint64_t* valueOf(const FaultSimulator& s, int g) {
+        const std::vector<uint64_t>& values = (s.faultyEpoch[g] == s.epoch) ? s.faultyValues : s.goodValues;
+        return &values[size_t(g) * 2 * B];
+    }
+
+    // Evaluates gate g from the current (faulty where set) input values
+    template <int B> static KERNEL_INLINE void evaluate(const FaultSimulator& s, int g, W<B>& one, W<B>& zero) {
+        const W<B> none = {};
+        IdRange inputs = s.netlist.getInputs(g);
+        GateType type = s.netlist.getType(g);
+        W<B> a1, a0, t;
+
+        switch (type) {
+            case GateType::PI:
+                load<B>(one, &s.goodValues[size_t(g) * 2 * B]);
+                load<B>(zero, &s.goodValues[size_t(g) * 2 * B + B]);
+                return;
+            case GateType::PO:
+            case GateType::BUFF:
+            case GateType::FANOUT:
+            case GateType::NOT:
+                one = zero = none;
+                if (!inputs.empty()) {
+                    load<B>(one, valueOf<B>(s, inputs[0]));
+                    load<B>(zero, valueOf<B>(s, inputs[0]) + B);
+                }
+                break;
+            case GateType::AND:
+            case GateType::NAND:
+                one = ~none;
+                zero = none;
+                for (int in : inputs) {
+                    load<B>(a1, valueOf<B>(s, in));
+                    load<B>(a0, valueOf<B>(s, in) + B);
+                    one &= a1;
+                    zero |= a0;
+                }
+                break;
+            case GateType::OR:
+            case GateType::NOR:
+                one = none;
+                zero = ~none;
+                for (int in : inputs) {
+                    load<B>(a1, valueOf<B>(s, in));
+                    load<B>(a0, valueOf<B>(s, in) + B);
+                    one |= a1;
+                    zero &= a0;
+                }
+                break;
+            case GateType::XOR:
+            case GateType::XNOR:
+                one = none;
+                zero = ~none;
+                for (int in : inputs) {
+                    load<B>(a1, valueOf<B>(s, in));
+                    load<B>(a0, valueOf<B>(s, in) + B);
+                    t = (one & a0) | (zero & a1);
+                    zero = (one & a1) | (zero & a0);
+                    one = t;
+                }
+                break;
+            default:
+                one = zero = none;
+                return;
+        }
+
+        if (type == GateType::NOT || type == GateType::NAND ||
+            type == GateType::NOR || type == GateType::XNOR) {
+            t = one;
+            one = zero;
+            zero = t;
+        }
+    }
+
+    template <int B> static KERNEL_INLINE void simulateGood(FaultSimulator& s) {
+        W<B> one, zero;
+        for (int g = 0; g < s.netlist.getSimulationCount(); ++g) {
+            if (s.netlist.getType(g) == GateType::PI) {
+                continue;
+            }
+            evaluate<B>(s, g, one, zero);
+            store<B>(&s.goodValues[size_t(g) * 2 * B], one);
+            store<B>(&s.goodValues[size_t(g) * 2 * B + B], zero);
+        }
+    }
+
+    template <int B> static KERNEL_INLINE int simulateFault(FaultSimulator& s, int site, FaultType fault) {
+        const W<B> none = {};
+        W<B> valid, good1, good0;
+        load<B>(valid, s.validMask.data());
+        load<B>(good1, &s.goodValues[size_t(site) * 2 * B]);
+        load<B>(good0, &s.goodValues[size_t(site) * 2 * B + B]);
+
+        W<B> stuck1 = (fault == FaultType::SA1) ? valid : none;
+        W<B> stuck0 = (fault == FaultType::SA0) ? valid : none;
+        if (!any<B>((stuck1 ^ good1) | (stuck0 ^ good0))) {
+            return -1; // Not activated by any loaded pattern
+        }
+        store<B>(&s.faultyValues[size_t(site) * 2 * B], stuck1);
+        store<B>(&s.faultyValues[size_t(site) * 2 * B + B], stuck0);
+        s.faultyEpoch[site] = s.epoch;
+
+        // A pattern detects the fault where good and faulty are both known and differ
+        W<B> detected = none;
+        if (s.netlist.getType(site) == GateType::PO) {
+            detected |= (good1 & stuck0) | (good0 & stuck1);
+        }
+        s.scheduleFanout(site);
+
+        W<B> faulty1, faulty0;
+        for (size_t lvl = s.netlist.getLevel(site) + 1; lvl < s.eventQueue.size() && s.pendingEvents > 0; ++lvl) {
+            for (int g : s.eventQueue[lvl]) {
+                s.scheduled[g] = false;
+                s.pendingEvents--;
+
+                evaluate<B>(s, g, faulty1, faulty0);
+                load<B>(good1, &s.goodValues[size_t(g) * 2 * B]);
+                load<B>(good0, &s.goodValues[size_t(g) * 2 * B + B]);
+                if (!any<B>((faulty1 ^ good1) | (faulty0 ^ good0))) {
+                    continue; // Fault effect blocked here
+                }
+                store<B>(&s.faultyValues[size_t(g) * 2 * B], faulty1);
+                store<B>(&s.faultyValues[size_t(g) * 2 * B + B], faulty0);
+                s.faultyEpoch[g] = s.epoch;
+
+                if (s.netlist.getType(g) == GateType::PO) {
+                    detected |= (good1 & faulty0) | (good0 & faulty1);
+                }
+                s.scheduleFanout(g);
+            }
+            s.eventQueue[lvl].clear();
+        }
+
+        return firstSetBit<B>(detected & valid);
+    }
+};
+
+// --- Dispatch ---
+// Scalar and 2-word blocks need nothing beyond the baseline target (SSE2 on
+// x86-64, NEON on arm64). The AVX kernels are only reached after a CPUID check.
+static void simulateGood1(FaultSimulator& s) { FaultSimKernel::simulateGood<1>(s); }
+static void simulateGood2(FaultSimulator& s) { FaultSimKernel::simulateGood<2>(s); }
+static int simulateFault1(FaultSimulator& s, int site, FaultType f) { return FaultSimKernel::simulateFault<1>(s, site, f); }
+static int simulateFault2(FaultSimulator& s, int site, FaultType f) { return FaultSimKernel::simulateFault<2>(s, site, f); }
+
+#ifdef FAULTSIM_X86_KERNELS
+__attribute__((target("avx2")))
+static void simulateGood4(FaultSimulator& s) { FaultSimKernel::simulateGood<4>(s); }
+__attribute__((target("avx2")))
+static int simulateFault4(FaultSimulator& s, int site, FaultType f) { return FaultSimKernel::simulateFault<4>(s, site, f); }
+__attribute__((target("avx512f")))
+static void simulateGood8(FaultSimulator& s) { FaultSimKernel::simulateGood<8>(s); }
+__attribute__((target("avx512f")))
+static int simulateFault8(FaultSimulator& s, int site, FaultType f) { return FaultSimKernel::simulateFault<8>(s, site, f); }
+#endif
+
+int FaultSimulator::widestSupportedBlock() {
+#ifdef FAULTSIM_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return 8;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return 4;
+    }
+#endif
+    return 2;
+}
+
+FaultSimulator::FaultSimulator(const Netlist& nl, int requestedWords)
+    : netlist(nl), blockWords(1), epoch(0), patternCount(0), pendingEvents(0) {
+    int widest = widestSupportedBlock();
+    while (blockWords * 2 <= requestedWords && blockWords * 2 <= widest) {
+        blockWords *= 2;
+    }
+
+    size_t n = netlist.getGateCount();
+    goodValues.assign(n * 2 * blockWords, 0);
+    faultyValues.assign(n * 2 * blockWords, 0);
+    faultyEpoch.assign(n, 0);
+    validMask.assign(blockWords, 0);
+    eventQueue.assign(netlist.getLevelCount(), {});
+    scheduled.assign(n, false);
+}
+
+void FaultSimulator::clearPatterns() {
+    patternCount = 0;
+    std::fill(validMask.begin(), validMask.end(), 0);
+    for (int pi : netlist.getPIs()) {
+        std::fill_n(&goodValues[size_t(pi) * 2 * blockWords], 2 * blockWords, 0);
+    }
+}
+
+void FaultSimulator::addPattern(const std::vector<LogicValue>& piValues) {
+    int word = patternCount / PATTERNS_PER_WORD;
+    uint64_t bit = uint64_t(1) << (patternCount % PATTERNS_PER_WORD);
+    IdRange pis = netlist.getPIs();
+    for (size_t i = 0; i < pis.size() && i < piValues.size(); ++i) {
+        uint64_t* w = &goodValues[size_t(pis[i]) * 2 * blockWords];
+        if (piValues[i] == LogicValue::ONE) {
+            w[word] |= bit;
+        } else if (piValues[i] == LogicValue::ZERO) {
+            w[blockWords + word] |= bit;
+        }
+    }
+    validMask[word] |= bit;
+    patternCount++;
+}
+
+void FaultSimulator::simulateGood() {
+    // A fresh epoch hides every faulty value from the previous fault
+    epoch++;
+    switch (blockWords) {
+#ifdef FAULTSIM_X86_KERNELS
+        case 8: simulateGood8(*this); break;
+        case 4: simulateGood4(*this); break;
+#endif
+        case 2: simulateGood2(*this); break;
+        default: simulateGood1(*this); break;
+    }
+}
+
+void FaultSimulator::scheduleFanout(int g) {
+    for (int out : netlist.getOutputs(g)) {
+        if (!scheduled[out] && netlist.getLevel(out) >= 0) {
+            scheduled[out] = true;
+            eventQueue[netlist.getLevel(out)].push_back(out);
+            pendingEvents++;
+        }
+    }
+}
+
+int FaultSimulator::simulateFault(int site, FaultType fault) {
+    if (netlist.getLevel(site) < 0 || fault == FaultType::NO_FAULT) {
+        return -1;
+    }
+    epoch++;
+
+    switch (blockWords) {
+#ifdef FAULTSIM_X86_KERNELS
+        case 8: return simulateFault8(*this, site, fault);
+        case 4: return simulateFault4(*this, site, fault);
+#endif
+        case 2: return simulateFault2(*this, site, fault);
+        default: return simulateFault1(*this, site, fault);
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef FAULT_SIMULATOR_H
+#define FAULT_SIMULATOR_H
+
+#include "Netlist.h"
+#include "logic.h"
+#include <cstdint>
+#include <vector>
+
+// Parallel-pattern single-fault propagation (PPSFP) simulator.
+// Every net carries a block of patterns at once, one bit per pattern, so a
+// gate evaluation is a handful of bitwise operations on machine words.
+// A block is 1, 2, 4 or 8 words wide; the wider blocks are evaluated with
+// SSE2, AVX2 or AVX-512 kernels picked at run time.
+class FaultSimulator {
+public:
+    static const int PATTERNS_PER_WORD = 64;
+    static const int MAX_BLOCK_WORDS = 8;
+
+    // Widest block this CPU has a vector kernel for
+    static int widestSupportedBlock();
+
+    // blockWords is clamped to a supported width. The values of a net are
+    // stored as blockWords 'one' words followed by blockWords 'zero' words:
+    // bit i is set in 'one' if pattern i is 1 on the net, in 'zero' if it
+    // is 0, and in neither if it is X.
+    explicit FaultSimulator(const Netlist& n, int blockWords = 1);
+
+    // --- Pattern Loading ---
+    // Patterns hold one value per PI, in Netlist::getPIs() order (0, 1 or X)
+    void clearPatterns();
+    void addPattern(const std::vector<LogicValue>& piValues);
+    int getPatternCount() const { return patternCount; }
+    int getCapacity() const { return blockWords * PATTERNS_PER_WORD; }
+    bool isFull() const { return patternCount == getCapacity(); }
+
+    // --- Simulation ---
+    // Good-machine simulation of the loaded patterns
+    void simulateGood();
+
+    // Injects one stuck-at fault and propagates it through its fanout cone.
+    // Returns the index of the first loaded pattern that detects it at
+    // some PO, or -1 if none does.
+    int simulateFault(int site, FaultType fault);
+
+private:
+    friend struct FaultSimKernel;
+
+    void scheduleFanout(int g);
+
+    const Netlist& netlist;
+    int blockWords;
+
+    std::vector<uint64_t> goodValues;   // 2 * blockWords words per gate id
+    std::vector<uint64_t> faultyValues; // Only valid where faultyEpoch matches
+    std::vector<unsigned> faultyEpoch;
+    unsigned epoch;
+
+    int patternCount;
+    std::vector<uint64_t> validMask;    // blockWords words
+
+    // One bucket of pending gates per level, as in SimState::assignAndImply
+    std::vector<std::vector<int>> eventQueue;
+    std::vector<bool> scheduled;
+    int pendingEvents;
+};
+
+#endif // FAULT_SIMULATOR_H
@@ -1,14 +1,7 @@
 #include "Gate.h"
 
-Gate::Gate(const std::string& name, GateType type)
-    : name(name), 
+Gate::Gate(GateType type, std::pmr::memory_resource* arena)
+    : arena(arena),
       type(type), 
-      value(LogicValue::UNSET),
-      fault(FaultType::NO_FAULT) {}
-
-void Gate::clearValue() {
-    // PIs hold their value, others are unknown
-    if (type != GateType::PI) {
-        value = LogicValue::UNSET;
-    }
-}
\ No newline at end of file
+      id(-1),
+      level(-1) {}
@@ -3,36 +3,75 @@
 
 #include "logic.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <algorithm> // For std::find
+#include <cstdint>
 
+class Gate;
+
+// Fanin or fanout list stored in the Circuit's arena. It grows by
+// doubling; the old block is simply left to the arena.
+class GateList {
+public:
+    Gate* const* begin() const { return items; }
+    Gate* const* end() const { return items + count; }
+    Gate** begin() { return items; }
+    Gate** end() { return items + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    Gate* operator[](size_t i) const { return items[i]; }
+
+    void push_back(Gate* gate, std::pmr::memory_resource* arena) {
+        if (count == capacity) {
+            reserve(capacity ? 2 * capacity : 1, arena);
+        }
+        items[count++] = gate;
+    }
+    void reserve(size_t n, std::pmr::memory_resource* arena) {
+        if (n <= capacity) {
+            return;
+        }
+        Gate** grown = static_cast<Gate**>(arena->allocate(n * sizeof(Gate*), alignof(Gate*)));
+        std::copy(items, items + count, grown);
+        items = grown;
+        capacity = uint32_t(n);
+    }
+    void clear() { count = 0; }
+
+private:
+    Gate** items = nullptr;
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+};
+
+// Gates are placed in their Circuit's arena, and their adjacency lists
+// live there too. The arena is released in one piece, so gate destructors
+// never run and must not be relied on. A gate's name is kept only in the
+// Circuit's NameTable, under the gate's id (see Circuit::getName).
 class Gate {
 public:
-    // Constructor
-    Gate(const std::string& name, GateType type);
+    Gate(GateType type, std::pmr::memory_resource* arena);
     
     virtual ~Gate() = default;
 
-    // --- Pure Virtual Functions ---
-    virtual LogicValue evaluate() = 0; 
-
-    // --- Common Functions ---
-    void clearValue();
-    
     // Getters
-    const std::string& getName() const { return name; }
     GateType getType() const { return type; }
-    LogicValue getValue() const { return value; }
-    const std::vector<Gate*>& getInputs() const { return inputs; }
-    const std::vector<Gate*>& getOutputs() const { return outputs; }
+    int getId() const { return id; }
+    int getLevel() const { return level; }
+    const GateList& getInputs() const { return inputs; }
+    const GateList& getOutputs() const { return outputs; }
 
     // Setters
-    void addInput(Gate* gate) { inputs.push_back(gate); }
-    void addOutput(Gate* gate) { outputs.push_back(gate); }
-    void setValue(LogicValue val) { this->value = val; }
-    void setFault(FaultType f) { this->fault = f; }
-    FaultType getFault() const { return fault; }
+    void addInput(Gate* gate) { inputs.push_back(gate, arena); }
+    void addOutput(Gate* gate) { outputs.push_back(gate, arena); }
+    // Exact sizes up front, so the lists never regrow inside the arena
+    void reserveInputs(size_t n) { inputs.reserve(n, arena); }
+    void reserveOutputs(size_t n) { outputs.reserve(n, arena); }
+    void setId(int newId) { this->id = newId; }
+    void setLevel(int lvl) { this->level = lvl; }
 
     // --- NEW HELPERS FOR FANOUT ---
     void clearOutputs() { outputs.clear(); }
@@ -44,13 +83,13 @@ public:
     }
 
 protected:
-    std::string name;
+    std::pmr::memory_resource* arena;
     GateType type;
-    LogicValue value;
-    FaultType fault;
+    int id;     // Index into Circuit::allGates, and the gate's name id
+    int level;  // Topological level (-1 until buildSimulationList runs)
     
-    std::vector<Gate*> inputs;
-    std::vector<Gate*> outputs;
+    GateList inputs;
+    GateList outputs;
 };
 
 #endif // GATE_H
\ No newline at end of file
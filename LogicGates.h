@@ -2,80 +2,68 @@
 #define LOGIC_GATES_H
 
 #include "Gate.h"
-#include "logic_util.h"
 #include <vector>
 
 // --- Primary Input (PI) ---
 class PiGate : public Gate {
 public:
-    PiGate(const std::string& name);
-    LogicValue evaluate() override;
+    PiGate(std::pmr::memory_resource* arena);
 };
 
 // --- Primary Output (PO) ---
 class PoGate : public Gate {
 public:
-    PoGate(const std::string& name);
-    LogicValue evaluate() override;
+    PoGate(std::pmr::memory_resource* arena);
 };
 
 // --- NOT Gate ---
 class NotGate : public Gate {
 public:
-    NotGate(const std::string& name);
-    LogicValue evaluate() override;
+    NotGate(std::pmr::memory_resource* arena);
 };
 
 // --- Buffer Gate ---
 class BuffGate : public Gate {
 public:
-    BuffGate(const std::string& name);
-    LogicValue evaluate() override;
+    BuffGate(std::pmr::memory_resource* arena);
 };
 
 // --- Fanout Gate (NEW) ---
 class FanoutGate : public Gate {
 public:
-    FanoutGate(const std::string& name);
-    LogicValue evaluate() override;
+    FanoutGate(std::pmr::memory_resource* arena);
 };
 
 // --- 2-Input Gates ---
 class AndGate : public Gate {
 public:
-    AndGate(const std::string& name);
-    LogicValue evaluate() override;
+    AndGate(std::pmr::memory_resource* arena);
 };
 
 class OrGate : public Gate {
 public:
-    OrGate(const std::string& name);
-    LogicValue evaluate() override;
+    OrGate(std::pmr::memory_resource* arena);
 };
 
 // --- Multi-Input Gates (Handle > 2 inputs) ---
 class NandGate : public Gate {
 public:
-    NandGate(const std::string& name);
-    LogicValue evaluate() override;
+    NandGate(std::pmr::memory_resource* arena);
 };
 
 class NorGate : public Gate {
 public:
-    NorGate(const std::string& name);
-    LogicValue evaluate() override;
+    NorGate(std::pmr::memory_resource* arena);
 };
 
 class XorGate : public Gate {
 public:
-    XorGate(const std::string& name);
-    LogicValue evaluate() override;
+    XorGate(std::pmr::memory_resource* arena);
 };
 
 class XnorGate : public Gate {
 public:
-    XnorGate(const std::string& name);
-    LogicValue evaluate() override;
+    XnorGate(std::pmr::memory_resource* arena);
 };
 
 #endif // LOGIC_GATES_H
\ No newline at end of file
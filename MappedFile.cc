@@ -0,0 +1,42 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        opened = true;
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                bytes = static_cast<const char*>(p);
+            } else {
+                opened = false;
+                length = 0;
+            }
+        }
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (bytes) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+}
+
+uint64_t contentHash(std::string_view bytes) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
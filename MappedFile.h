@@ -0,0 +1,31 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Read-only mapping of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return bytes ? bytes : ""; }
+    size_t size() const { return length; }
+    std::string_view text() const { return std::string_view(data(), length); }
+
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+};
+
+// 64-bit FNV-1a over a byte range
+uint64_t contentHash(std::string_view bytes);
+
+#endif // MAPPED_FILE_H
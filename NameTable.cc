@@ -0,0 +1,58 @@
+#include "NameTable.h"
+#include "MappedFile.h" // contentHash
+
+NameTable::NameTable() : offsets(1, 0), slots(16, -1) {}
+
+static size_t hash(std::string_view name) {
+    return size_t(contentHash(name));
+}
+
+void NameTable::reserve(int count, size_t bytes) {
+    chars.reserve(bytes);
+    offsets.reserve(size_t(count) + 1);
+    while (size_t(count) * 2 > slots.size()) {
+        grow();
+    }
+}
+
+int NameTable::find(std::string_view name) const {
+    size_t mask = slots.size() - 1;
+    for (size_t slot = hash(name) & mask; slots[slot] >= 0; slot = (slot + 1) & mask) {
+        if (getName(slots[slot]) == name) {
+            return slots[slot];
+        }
+    }
+    return -1;
+}
+
+int NameTable::intern(std::string_view name) {
+    size_t mask = slots.size() - 1;
+    size_t slot = hash(name) & mask;
+    for (; slots[slot] >= 0; slot = (slot + 1) & mask) {
+        if (getName(slots[slot]) == name) {
+            return slots[slot];
+        }
+    }
+
+    int id = size();
+    chars.append(name.data(), name.size());
+    offsets.push_back(chars.size());
+    slots[slot] = id;
+    // Keep the load factor at or below one half
+    if (size_t(size()) * 2 > slots.size()) {
+        grow();
+    }
+    return id;
+}
+
+void NameTable::grow() {
+    slots.assign(slots.size() * 2, -1);
+    size_t mask = slots.size() - 1;
+    for (int id = 0; id < size(); ++id) {
+        size_t slot = hash(getName(id)) & mask;
+        while (slots[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+}
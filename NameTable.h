@@ -0,0 +1,37 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Interns names as dense ids 0, 1, 2, ... in first-seen order. The
+// characters are stored back to back in one buffer and looked up through
+// an open-addressing hash table, so a lookup never allocates.
+class NameTable {
+public:
+    NameTable();
+
+    // Pre-sizes the table for 'count' names totalling 'bytes' characters
+    void reserve(int count, size_t bytes);
+
+    // Returns the id of 'name', adding it if it is new
+    int intern(std::string_view name);
+    // Returns -1 if 'name' was never interned
+    int find(std::string_view name) const;
+
+    // Valid until the next intern()
+    std::string_view getName(int id) const {
+        return std::string_view(chars.data() + offsets[id], offsets[id + 1] - offsets[id]);
+    }
+    int size() const { return int(offsets.size()) - 1; }
+
+private:
+    void grow();
+
+    std::string chars;
+    std::vector<size_t> offsets; // size() + 1 entries
+    std::vector<int> slots;      // Ids, -1 = empty; size is a power of two
+};
+
+#endif // NAME_TABLE_H
@@ -0,0 +1,406 @@
+#include "Netlist.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+
+size_t nameHash(std::string_view name) {
+    return size_t(contentHash(name));
+}
+
+} // namespace
+
+Netlist::Netlist(Circuit& c) {
+    const auto& allGates = c.getAllGates();
+    size_t n = allGates.size();
+
+    // 1. Renumber: levelized gates first, in simulation order,
+    // then anything the topological sort could not reach
+    std::vector<int> newId(n, -1);
+    std::vector<const Gate*> byNewId;
+    byNewId.reserve(n);
+    for (Gate* g : c.getSimulationList()) {
+        newId[g->getId()] = byNewId.size();
+        byNewId.push_back(g);
+    }
+    counts.simulation = byNewId.size();
+    for (Gate* g : allGates) {
+        if (newId[g->getId()] < 0) {
+            newId[g->getId()] = byNewId.size();
+            byNewId.push_back(g);
+        }
+    }
+
+    // 2. Size every array, then lay them out in one image
+    counts.gates = n;
+    counts.levels = c.getLevelCount();
+    counts.pis = c.getPIs().size();
+    counts.pos = c.getPOs().size();
+    for (const Gate* g : byNewId) {
+        counts.inputIds += g->getInputs().size();
+        counts.outputIds += g->getOutputs().size();
+        counts.nameBytes += c.getName(g).size();
+    }
+    counts.nameIndex = 16;
+    while (counts.nameIndex < 2 * counts.gates) {
+        counts.nameIndex *= 2;
+    }
+    layout = computeLayout(counts);
+    image.assign((layout.size + 7) / 8, 0);
+
+    // 3. Flatten per-gate data and connectivity
+    GateType* typesOut = writable<GateType>(layout.types);
+    int* levelsOut = writable<int>(layout.levels);
+    LogicValue* initialOut = writable<LogicValue>(layout.initialValues);
+    int* inputOffsetsOut = writable<int>(layout.inputOffsets);
+    int* inputIdsOut = writable<int>(layout.inputIds);
+    int* outputOffsetsOut = writable<int>(layout.outputOffsets);
+    int* outputIdsOut = writable<int>(layout.outputIds);
+    uint64_t* nameOffsetsOut = writable<uint64_t>(layout.nameOffsets);
+    char* nameCharsOut = writable<char>(layout.nameChars);
+    int* nameIndexOut = writable<int>(layout.nameIndex);
+    std::fill_n(nameIndexOut, counts.nameIndex, -1);
+
+    int inputAt = 0;
+    int outputAt = 0;
+    uint64_t nameAt = 0;
+    size_t slotMask = counts.nameIndex - 1;
+    for (size_t id = 0; id < n; ++id) {
+        const Gate* g = byNewId[id];
+        typesOut[id] = g->getType();
+        levelsOut[id] = g->getLevel();
+        initialOut[id] = (g->getType() == GateType::PI) ? LogicValue::X : LogicValue::UNSET;
+
+        inputOffsetsOut[id] = inputAt;
+        for (Gate* in : g->getInputs()) {
+            inputIdsOut[inputAt++] = newId[in->getId()];
+        }
+        outputOffsetsOut[id] = outputAt;
+        for (Gate* out : g->getOutputs()) {
+            outputIdsOut[outputAt++] = newId[out->getId()];
+        }
+
+        std::string_view name = c.getName(g);
+        nameOffsetsOut[id] = nameAt;
+        std::copy(name.begin(), name.end(), nameCharsOut + nameAt);
+        nameAt += name.size();
+        size_t slot = nameHash(name) & slotMask;
+        while (nameIndexOut[slot] >= 0) {
+            slot = (slot + 1) & slotMask;
+        }
+        nameIndexOut[slot] = id;
+    }
+    inputOffsetsOut[n] = inputAt;
+    outputOffsetsOut[n] = outputAt;
+    nameOffsetsOut[n] = nameAt;
+
+    // 4. Lists that keep the Circuit's original ordering
+    int* pisOut = writable<int>(layout.pis);
+    for (Gate* pi : c.getPIs()) {
+        *pisOut++ = newId[pi->getId()];
+    }
+    int* posOut = writable<int>(layout.pos);
+    for (Gate* po : c.getPOs()) {
+        *posOut++ = newId[po->getId()];
+    }
+    int* declarationOrderOut = writable<int>(layout.declarationOrder);
+    int* declarationRankOut = writable<int>(layout.declarationRank);
+    int rank = 0;
+    for (Gate* g : allGates) {
+        declarationRankOut[newId[g->getId()]] = rank;
+        declarationOrderOut[rank++] = newId[g->getId()];
+    }
+
+    bind(reinterpret_cast<const char*>(image.data()));
+    computeScoap();
+}
+
+Netlist::~Netlist() = default;
+
+int Netlist::findGate(std::string_view name) const {
+    size_t slotMask = counts.nameIndex - 1;
+    for (size_t slot = nameHash(name) & slotMask; nameIndex[slot] >= 0; slot = (slot + 1) & slotMask) {
+        if (getName(nameIndex[slot]) == name) {
+            return nameIndex[slot];
+        }
+    }
+    return -1;
+}
+
+// --- Image Layout ---
+
+// Every array starts on an 8-byte boundary
+Netlist::Layout Netlist::computeLayout(const Counts& c) {
+    Layout l;
+    size_t at = 0;
+    auto place = [&at](size_t bytes) {
+        size_t offset = at;
+        at += (bytes + 7) & ~size_t(7);
+        return offset;
+    };
+    size_t n = c.gates;
+    l.types = place(n * sizeof(GateType));
+    l.levels = place(n * sizeof(int));
+    l.inputOffsets = place((n + 1) * sizeof(int));
+    l.inputIds = place(c.inputIds * sizeof(int));
+    l.outputOffsets = place((n + 1) * sizeof(int));
+    l.outputIds = place(c.outputIds * sizeof(int));
+    l.pis = place(c.pis * sizeof(int));
+    l.pos = place(c.pos * sizeof(int));
+    l.declarationOrder = place(n * sizeof(int));
+    l.declarationRank = place(n * sizeof(int));
+    l.initialValues = place(n * sizeof(LogicValue));
+    l.cc0 = place(n * sizeof(int));
+    l.cc1 = place(n * sizeof(int));
+    l.co = place(n * sizeof(int));
+    l.observabilityOrder = place(n * sizeof(int));
+    l.observabilityRank = place(n * sizeof(int));
+    l.nameOffsets = place((n + 1) * sizeof(uint64_t));
+    l.nameChars = place(c.nameBytes);
+    l.nameIndex = place(c.nameIndex * sizeof(int));
+    l.size = at;
+    return l;
+}
+
+void Netlist::bind(const char* base) {
+    imageBase = base;
+    types = reinterpret_cast<const GateType*>(base + layout.types);
+    levels = reinterpret_cast<const int*>(base + layout.levels);
+    inputOffsets = reinterpret_cast<const int*>(base + layout.inputOffsets);
+    inputIds = reinterpret_cast<const int*>(base + layout.inputIds);
+    outputOffsets = reinterpret_cast<const int*>(base + layout.outputOffsets);
+    outputIds = reinterpret_cast<const int*>(base + layout.outputIds);
+    PIs = reinterpret_cast<const int*>(base + layout.pis);
+    POs = reinterpret_cast<const int*>(base + layout.pos);
+    declarationOrder = reinterpret_cast<const int*>(base + layout.declarationOrder);
+    declarationRank = reinterpret_cast<const int*>(base + layout.declarationRank);
+    initialValues = reinterpret_cast<const LogicValue*>(base + layout.initialValues);
+    cc0 = reinterpret_cast<const int*>(base + layout.cc0);
+    cc1 = reinterpret_cast<const int*>(base + layout.cc1);
+    co = reinterpret_cast<const int*>(base + layout.co);
+    observabilityOrder = reinterpret_cast<const int*>(base + layout.observabilityOrder);
+    observabilityRank = reinterpret_cast<const int*>(base + layout.observabilityRank);
+    nameOffsets = reinterpret_cast<const uint64_t*>(base + layout.nameOffsets);
+    nameChars = base + layout.nameChars;
+    nameIndex = reinterpret_cast<const int*>(base + layout.nameIndex);
+}
+
+// --- Binary Cache ---
+// File = CacheHeader followed by the image, byte for byte. Bump
+// CACHE_VERSION whenever the layout or the meaning of a field changes.
+static const char CACHE_MAGIC[8] = {'P', 'O', 'D', 'E', 'M', 'N', 'L', '\0'};
+static const uint32_t CACHE_VERSION = 1;
+
+struct Netlist::CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;   // 0x01020304 in the writer's byte order
+    uint32_t typeSizes;   // sizeof(GateType), sizeof(LogicValue), sizeof(int)
+    uint32_t reserved;
+    uint64_t sourceHash;
+    uint64_t imageSize;
+    Counts counts;
+};
+
+static uint32_t typeSizes() {
+    return uint32_t(sizeof(GateType)) | uint32_t(sizeof(LogicValue)) << 8 | uint32_t(sizeof(int)) << 16;
+}
+
+std::unique_ptr<Netlist> Netlist::load(const std::string& path, uint64_t sourceHash) {
+    static_assert(sizeof(CacheHeader) % 8 == 0, "image must stay 8-byte aligned");
+    auto file = std::make_unique<MappedFile>(path);
+    if (!file->isOpen() || file->size() < sizeof(CacheHeader)) {
+        return nullptr;
+    }
+    CacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION ||
+        header.byteOrder != 0x01020304 || header.typeSizes != typeSizes() || header.sourceHash != sourceHash) {
+        return nullptr;
+    }
+    const Counts& c = header.counts;
+    // Bounds the builder guarantees. findGate probes until it hits an empty
+    // slot, so the name table must be at most half full.
+    if (c.gates < 0 || c.simulation < 0 || c.simulation > c.gates || c.pis < 0 || c.pos < 0 || c.levels < 0 ||
+        c.inputIds < 0 || c.outputIds < 0 || c.nameBytes < 0 || c.nameIndex < 16 ||
+        (c.nameIndex & (c.nameIndex - 1)) != 0 || c.nameIndex < 2 * c.gates) {
+        return nullptr;
+    }
+    Layout layout = computeLayout(c);
+    if (header.imageSize != layout.size || file->size() != sizeof(CacheHeader) + layout.size) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Netlist> netlist(new Netlist());
+    netlist->counts = c;
+    netlist->layout = layout;
+    netlist->bind(file->data() + sizeof(CacheHeader));
+    netlist->mapping = std::move(file);
+    return netlist;
+}
+
+bool Netlist::save(const std::string& path, uint64_t sourceHash) const {
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.byteOrder = 0x01020304;
+    header.typeSizes = typeSizes();
+    header.sourceHash = sourceHash;
+    header.imageSize = layout.size;
+    header.counts = counts;
+
+    std::string tempPath = path + ".tmp." + std::to_string(getpid());
+    std::ofstream out(tempPath, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(imageBase, layout.size);
+    out.close();
+    if (!out || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// --- SCOAP ---
+const int Netlist::SCOAP_INFINITY;
+
+// Sums saturate so unreachable gates stay at SCOAP_INFINITY
+static int scoapAdd(int a, int b) {
+    return std::min(a + b, Netlist::SCOAP_INFINITY);
+}
+
+// Fills the SCOAP arrays of a freshly built image; the locals shadow
+// the read-only views of the same arrays
+void Netlist::computeScoap() {
+    size_t n = counts.gates;
+    int simulationCount = counts.simulation;
+    int* cc0 = writable<int>(layout.cc0);
+    int* cc1 = writable<int>(layout.cc1);
+    int* co = writable<int>(layout.co);
+    std::fill_n(cc0, n, SCOAP_INFINITY);
+    std::fill_n(cc1, n, SCOAP_INFINITY);
+    std::fill_n(co, n, SCOAP_INFINITY);
+
+    // 1. Controllability, inputs to outputs. PO and FANOUT gates are just
+    // net markers, so they cost nothing; every real gate adds 1.
+    for (int g = 0; g < simulationCount; ++g) {
+        IdRange inputs = getInputs(g);
+        int zero = SCOAP_INFINITY;
+        int one = SCOAP_INFINITY;
+
+        switch (types[g]) {
+            case GateType::PI:
+                zero = one = 1;
+                break;
+            case GateType::PO:
+            case GateType::FANOUT:
+            case GateType::BUFF:
+            case GateType::NOT:
+                if (!inputs.empty()) {
+                    zero = cc0[inputs[0]];
+                    one = cc1[inputs[0]];
+                }
+                break;
+            case GateType::AND:
+            case GateType::NAND:
+                // 1 needs every input at 1, 0 needs the easiest input at 0
+                one = 0;
+                for (int in : inputs) {
+                    zero = std::min(zero, cc0[in]);
+                    one = scoapAdd(one, cc1[in]);
+                }
+                break;
+            case GateType::OR:
+            case GateType::NOR:
+                zero = 0;
+                for (int in : inputs) {
+                    zero = scoapAdd(zero, cc0[in]);
+                    one = std::min(one, cc1[in]);
+                }
+                break;
+            case GateType::XOR:
+            case GateType::XNOR:
+                // Folded two inputs at a time, like the simulators evaluate it
+                zero = 0;
+                one = SCOAP_INFINITY;
+                for (int in : inputs) {
+                    int nextZero = std::min(scoapAdd(zero, cc0[in]), scoapAdd(one, cc1[in]));
+                    int nextOne = std::min(scoapAdd(zero, cc1[in]), scoapAdd(one, cc0[in]));
+                    zero = nextZero;
+                    one = nextOne;
+                }
+                break;
+        }
+
+        GateType type = types[g];
+        if (type == GateType::NOT || type == GateType::NAND ||
+            type == GateType::NOR || type == GateType::XNOR) {
+            std::swap(zero, one);
+        }
+        if (type != GateType::PI && type != GateType::PO && type != GateType::FANOUT) {
+            zero = scoapAdd(zero, 1);
+            one = scoapAdd(one, 1);
+        }
+        cc0[g] = zero;
+        cc1[g] = one;
+    }
+
+    // 2. Observability, outputs to inputs. A net is as observable as its
+    // easiest path: the min over its fanout of that gate's CO plus the cost
+    // of setting the gate's other inputs to non-controlling values.
+    for (int g = simulationCount - 1; g >= 0; --g) {
+        if (types[g] == GateType::PO) {
+            co[g] = 0;
+            continue;
+        }
+        int best = SCOAP_INFINITY;
+        for (int out : getOutputs(g)) {
+            if (levels[out] < 0) {
+                continue;
+            }
+            int cost = co[out];
+            GateType type = types[out];
+            if (type != GateType::FANOUT) {
+                cost = scoapAdd(cost, 1);
+            }
+            IdRange siblings = getInputs(out);
+            for (size_t i = 0; i < siblings.size(); ++i) {
+                int other = siblings[i];
+                if (other == g) {
+                    continue;
+                }
+                switch (type) {
+                    case GateType::AND:
+                    case GateType::NAND:
+                        cost = scoapAdd(cost, cc1[other]);
+                        break;
+                    case GateType::OR:
+                    case GateType::NOR:
+                        cost = scoapAdd(cost, cc0[other]);
+                        break;
+                    case GateType::XOR:
+                    case GateType::XNOR:
+                        cost = scoapAdd(cost, std::min(cc0[other], cc1[other]));
+                        break;
+                    default:
+                        break;
+                }
+            }
+            best = std::min(best, cost);
+        }
+        co[g] = best;
+    }
+
+    // 3. Selection order for guided D-frontier choice
+    int* order = writable<int>(layout.observabilityOrder);
+    std::copy(declarationOrder, declarationOrder + n, order);
+    std::stable_sort(order, order + n, [co](int a, int b) { return co[a] < co[b]; });
+    int* rank = writable<int>(layout.observabilityRank);
+    for (size_t r = 0; r < n; ++r) {
+        rank[order[r]] = r;
+    }
+}
@@ -0,0 +1,167 @@
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include "Circuit.h"
+#include "logic.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MappedFile;
+
+// A contiguous run of gate ids inside one of the Netlist's CSR arrays
+struct IdRange {
+    const int* first;
+    const int* last;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    int operator[](size_t i) const { return first[i]; }
+};
+
+// Frozen, compiled form of a Circuit, built once after buildSimulationList().
+//
+// Gates are renumbered in topological order, so a full simulation is a
+// single pass over ids [0, getSimulationCount()). Fanin and fanout live in
+// CSR offset/index arrays and the gate type is a one-byte opcode, so the
+// simulators dispatch on the opcode in a tight loop instead of chasing
+// Gate pointers through virtual calls. Per-run state stays in plain
+// arrays indexed by id (see SimState), and any number of runs can
+// share one Netlist.
+//
+// All arrays live in one flat image, so a netlist can be saved as a binary
+// cache file and later memory-mapped and used in place, without parsing.
+class Netlist {
+public:
+    explicit Netlist(Circuit& c);
+    ~Netlist();
+    Netlist(const Netlist&) = delete;
+    Netlist& operator=(const Netlist&) = delete;
+
+    // --- Binary Cache ---
+    // The file records a hash of the source .bench; load() returns nullptr
+    // if the file is missing, damaged, from another format version, or was
+    // built from a different source.
+    static std::unique_ptr<Netlist> load(const std::string& path, uint64_t sourceHash);
+    // Written to a temporary file and renamed into place, so concurrent
+    // runs never map a half-written cache
+    bool save(const std::string& path, uint64_t sourceHash) const;
+
+    // --- Gates ---
+    int getGateCount() const { return int(counts.gates); }
+    GateType getType(int id) const { return types[id]; }
+    std::string_view getName(int id) const {
+        return std::string_view(nameChars + nameOffsets[id], nameOffsets[id + 1] - nameOffsets[id]);
+    }
+    int getLevel(int id) const { return levels[id]; }
+    IdRange getInputs(int id) const {
+        return {inputIds + inputOffsets[id], inputIds + inputOffsets[id + 1]};
+    }
+    IdRange getOutputs(int id) const {
+        return {outputIds + outputOffsets[id], outputIds + outputOffsets[id + 1]};
+    }
+
+    // Returns -1 if no gate has this name
+    int findGate(std::string_view name) const;
+
+    // --- Structure ---
+    IdRange getPIs() const { return {PIs, PIs + counts.pis}; }
+    IdRange getPOs() const { return {POs, POs + counts.pos}; }
+    int getLevelCount() const { return int(counts.levels); }
+
+    // Gates [0, getSimulationCount()) are levelized, in topological order;
+    // any gates after that are on a cycle and never evaluated
+    int getSimulationCount() const { return int(counts.simulation); }
+
+    // Ids in the order the gates were declared in the Circuit (allGates)
+    IdRange getDeclarationOrder() const { return {declarationOrder, declarationOrder + counts.gates}; }
+    int getDeclarationRank(int id) const { return declarationRank[id]; }
+
+    // Values every run starts from: X on PIs, UNSET elsewhere (one per gate)
+    const LogicValue* getInitialValues() const { return initialValues; }
+
+    // --- SCOAP Testability ---
+    // Combinational controllability (CC0/CC1) and observability (CO),
+    // computed once when the netlist is built. Lower is easier. Gates that
+    // cannot be set or observed get SCOAP_INFINITY.
+    static const int SCOAP_INFINITY = 1 << 28;
+    int getCC0(int id) const { return cc0[id]; }
+    int getCC1(int id) const { return cc1[id]; }
+    int getCC(int id, LogicValue v) const { return (v == LogicValue::ZERO) ? cc0[id] : cc1[id]; }
+    int getCO(int id) const { return co[id]; }
+
+    // Ids sorted by CO, ties in declaration order, and each id's position
+    IdRange getObservabilityOrder() const { return {observabilityOrder, observabilityOrder + counts.gates}; }
+    int getObservabilityRank(int id) const { return observabilityRank[id]; }
+
+private:
+    // Element counts; together they fix the image layout
+    struct Counts {
+        int64_t gates = 0;
+        int64_t simulation = 0;
+        int64_t levels = 0;
+        int64_t pis = 0;
+        int64_t pos = 0;
+        int64_t inputIds = 0;
+        int64_t outputIds = 0;
+        int64_t nameBytes = 0;
+        int64_t nameIndex = 0; // Slots in the open-addressing name table
+    };
+    // Byte offset of each array in the image
+    struct Layout {
+        size_t types, levels, inputOffsets, inputIds, outputOffsets, outputIds, pis, pos;
+        size_t declarationOrder, declarationRank, initialValues;
+        size_t cc0, cc1, co, observabilityOrder, observabilityRank;
+        size_t nameOffsets, nameChars, nameIndex;
+        size_t size;
+    };
+    struct CacheHeader;
+
+    Netlist() = default;
+    static Layout computeLayout(const Counts& c);
+    void bind(const char* base);
+    template <class T> T* writable(size_t offset) {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(image.data()) + offset);
+    }
+
+    Counts counts;
+    Layout layout;
+    std::vector<uint64_t> image;         // Owned storage when built from a Circuit
+    std::unique_ptr<MappedFile> mapping; // Storage when loaded from a cache file
+    const char* imageBase = nullptr;
+
+    // Views into the image
+    const GateType* types = nullptr; // Opcodes
+    const int* levels = nullptr;
+
+    // CSR connectivity: gate i's fanins are inputIds[inputOffsets[i] .. inputOffsets[i+1])
+    const int* inputOffsets = nullptr;
+    const int* inputIds = nullptr;
+    const int* outputOffsets = nullptr;
+    const int* outputIds = nullptr;
+
+    const int* PIs = nullptr;
+    const int* POs = nullptr;
+    const int* declarationOrder = nullptr;
+    const int* declarationRank = nullptr;
+    const LogicValue* initialValues = nullptr;
+
+    void computeScoap();
+    const int* cc0 = nullptr;
+    const int* cc1 = nullptr;
+    const int* co = nullptr;
+    const int* observabilityOrder = nullptr;
+    const int* observabilityRank = nullptr;
+
+    // Names: gate i's is nameChars[nameOffsets[i] .. nameOffsets[i+1]).
+    // nameIndex is a linear-probing hash table of ids (-1 = empty).
+    const uint64_t* nameOffsets = nullptr;
+    const char* nameChars = nullptr;
+    const int* nameIndex = nullptr;
+};
+
+#endif // NETLIST_H
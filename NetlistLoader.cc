@@ -0,0 +1,83 @@
+#include "NetlistLoader.h"
+#include "BenchReader.h"
+#include "MappedFile.h"
+#include "logic.h"
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "parser.tab.h"
+
+extern "C" FILE *yyin;
+
+NetlistLoader::NetlistLoader(std::ostream& i, std::ostream& w) : info(i), warnings(w) {}
+
+bool NetlistLoader::readLegacy(const std::string& benchFile, Circuit& circuit, std::string& error) {
+    static std::mutex lexerMutex;
+    std::lock_guard<std::mutex> lock(lexerMutex);
+
+    FILE* bench = fopen(benchFile.c_str(), "r");
+    if (!bench) {
+        error = "Cannot open bench file " + benchFile;
+        return false;
+    }
+    yyin = bench;
+    yyparse(circuit);
+    fclose(bench);
+    yyin = nullptr;
+    return true;
+}
+
+// Parses a .bench file into 'circuit' and prepares it for simulation
+bool NetlistLoader::loadCircuit(const std::string& benchFile, Circuit& circuit) {
+    if (legacyParser) {
+        if (!readLegacy(benchFile, circuit, error)) {
+            return false;
+        }
+    } else {
+        BenchReader reader;
+        if (!reader.read(benchFile, circuit)) {
+            error = reader.getError();
+            return false;
+        }
+        for (const std::string& name : reader.getUndrivenNets()) {
+            warnings << "Warning: net " << name << " is used but never defined" << std::endl;
+        }
+    }
+
+    circuit.buildSimulationList();
+    info << "Circuit parsed and ready." << std::endl;
+    return true;
+}
+
+std::unique_ptr<Netlist> NetlistLoader::load(const std::string& benchFile) {
+    error.clear();
+    uint64_t sourceHash = 0;
+    if (!cacheFile.empty()) {
+        MappedFile source(benchFile);
+        if (!source.isOpen()) {
+            error = "Cannot open bench file " + benchFile;
+            return nullptr;
+        }
+        // The parsers differ on forward references, so each gets its own key
+        sourceHash = contentHash(source.text()) ^ (legacyParser ? 1 : 0);
+        if (std::unique_ptr<Netlist> cached = Netlist::load(cacheFile, sourceHash)) {
+            info << "Netlist loaded from cache " << cacheFile << std::endl;
+            return cached;
+        }
+    }
+
+    Circuit circuit;
+    if (!loadCircuit(benchFile, circuit)) {
+        return nullptr;
+    }
+    auto netlist = std::make_unique<Netlist>(circuit);
+    if (!cacheFile.empty()) {
+        if (netlist->save(cacheFile, sourceHash)) {
+            info << "Netlist cache written to " << cacheFile << std::endl;
+        } else {
+            warnings << "Warning: Cannot write netlist cache " << cacheFile << std::endl;
+        }
+    }
+    return netlist;
+}
@@ -0,0 +1,46 @@
+#ifndef NETLIST_LOADER_H
+#define NETLIST_LOADER_H
+
+#include "Circuit.h"
+#include "Netlist.h"
+#include <memory>
+#include <ostream>
+#include <string>
+
+// Turns a .bench file into a compiled Netlist: parse, build the
+// simulation list, compile, and optionally go through a binary cache.
+//
+// Loaders may run on several threads at once. The built-in reader keeps
+// all of its state in the BenchReader; the Flex lexer behind the legacy
+// parser has global state, so legacy parses are serialized.
+class NetlistLoader {
+public:
+    // Progress lines ("Circuit parsed and ready.", cache hits) go to
+    // 'info', warnings (undriven nets, cache write failures) to 'warnings'
+    NetlistLoader(std::ostream& info, std::ostream& warnings);
+
+    void setLegacyParser(bool legacy) { legacyParser = legacy; }
+    // Given a cache file, a cache made from the same .bench content is
+    // mapped instead of parsing, and a missing or stale one is rebuilt
+    // and written
+    void setCacheFile(const std::string& path) { cacheFile = path; }
+
+    // Returns nullptr on failure, with getError() set
+    std::unique_ptr<Netlist> load(const std::string& benchFile);
+    const std::string& getError() const { return error; }
+
+    // Parses 'benchFile' into an empty 'circuit' (before
+    // buildSimulationList()) with the Flex/Bison parser
+    static bool readLegacy(const std::string& benchFile, Circuit& circuit, std::string& error);
+
+private:
+    bool loadCircuit(const std::string& benchFile, Circuit& circuit);
+
+    std::ostream& info;
+    std::ostream& warnings;
+    bool legacyParser = false;
+    std::string cacheFile;
+    std::string error;
+};
+
+#endif // NETLIST_LOADER_H
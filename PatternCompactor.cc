@@ -0,0 +1,129 @@
+#include "PatternCompactor.h"
+#include "FaultSimulator.h"
+#include <algorithm>
+#include <unordered_set>
+
+PatternCompactor::PatternCompactor(const Netlist& n) : netlist(n), cubeCount(0), mergedCount(0) {}
+
+static bool isVectorLine(const std::string& line, size_t numPIs) {
+    return line.size() == numPIs && line.find_first_not_of("01X") == std::string::npos;
+}
+
+static size_t countSpecified(const std::string& cube) {
+    return cube.size() - std::count(cube.begin(), cube.end(), 'X');
+}
+
+// Greedy first-fit merging, most specified cubes first: they are the
+// hardest to place, and sparse cubes then fill in around them
+std::vector<std::string> PatternCompactor::mergeCubes(const std::vector<std::string>& cubes) const {
+    std::vector<size_t> order(cubes.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return countSpecified(cubes[a]) > countSpecified(cubes[b]);
+    });
+
+    std::vector<std::string> merged;
+    for (size_t i : order) {
+        const std::string& cube = cubes[i];
+        bool placed = false;
+        for (std::string& pattern : merged) {
+            bool compatible = true;
+            for (size_t k = 0; k < cube.size() && compatible; ++k) {
+                compatible = cube[k] == 'X' || pattern[k] == 'X' || cube[k] == pattern[k];
+            }
+            if (!compatible) {
+                continue;
+            }
+            for (size_t k = 0; k < cube.size(); ++k) {
+                if (cube[k] != 'X') {
+                    pattern[k] = cube[k];
+                }
+            }
+            placed = true;
+            break;
+        }
+        if (!placed) {
+            merged.push_back(cube);
+        }
+    }
+    return merged;
+}
+
+void PatternCompactor::compact(const std::vector<FaultSpec>& faults, const std::vector<std::string>& lines) {
+    size_t numPIs = netlist.getPIs().size();
+
+    // 1. Distinct cubes, in fault order
+    std::vector<std::string> cubes;
+    std::unordered_set<std::string> seen;
+    for (const std::string& line : lines) {
+        if (isVectorLine(line, numPIs) && seen.insert(line).second) {
+            cubes.push_back(line);
+        }
+    }
+    cubeCount = cubes.size();
+    std::vector<std::string> merged = mergeCubes(cubes);
+    mergedCount = merged.size();
+
+    // 2. Reverse-order fault simulation with dropping. Within a block the
+    // simulator reports the first detecting pattern, so loading the
+    // patterns last-to-first credits each fault exactly as a one-by-one
+    // reverse pass would.
+    std::vector<int> sites(faults.size());
+    std::vector<FaultType> types(faults.size());
+    for (size_t f = 0; f < faults.size(); ++f) {
+        sites[f] = netlist.findGate(faults[f].gateName);
+        types[f] = (faults[f].value == 0) ? FaultType::SA0 : FaultType::SA1;
+    }
+
+    FaultSimulator simulator(netlist, FaultSimulator::MAX_BLOCK_WORDS);
+    std::vector<int> credited(faults.size(), -1); // Index into 'merged'
+    std::vector<LogicValue> piValues(numPIs);
+    std::vector<int> blockIndex;
+    size_t next = merged.size();
+    while (next > 0) {
+        simulator.clearPatterns();
+        blockIndex.clear();
+        while (next > 0 && !simulator.isFull()) {
+            --next;
+            for (size_t i = 0; i < numPIs; ++i) {
+                char c = merged[next][i];
+                piValues[i] = (c == '1') ? LogicValue::ONE : (c == '0') ? LogicValue::ZERO : LogicValue::X;
+            }
+            simulator.addPattern(piValues);
+            blockIndex.push_back(next);
+        }
+        simulator.simulateGood();
+        for (size_t f = 0; f < faults.size(); ++f) {
+            if (credited[f] >= 0 || sites[f] < 0) {
+                continue;
+            }
+            int first = simulator.simulateFault(sites[f], types[f]);
+            if (first >= 0) {
+                credited[f] = blockIndex[first];
+            }
+        }
+    }
+
+    // 3. Keep the credited patterns, in their original order
+    std::vector<int> newIndex(merged.size(), -1);
+    patterns.clear();
+    for (size_t f = 0; f < faults.size(); ++f) {
+        if (credited[f] >= 0) {
+            newIndex[credited[f]] = 0;
+        }
+    }
+    for (size_t p = 0; p < merged.size(); ++p) {
+        if (newIndex[p] >= 0) {
+            newIndex[p] = patterns.size();
+            patterns.push_back(merged[p]);
+        }
+    }
+    faultPattern.assign(faults.size(), -1);
+    for (size_t f = 0; f < faults.size(); ++f) {
+        if (credited[f] >= 0) {
+            faultPattern[f] = newIndex[credited[f]];
+        }
+    }
+}
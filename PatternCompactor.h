@@ -0,0 +1,45 @@
+#ifndef PATTERN_COMPACTOR_H
+#define PATTERN_COMPACTOR_H
+
+#include "AtpgRunner.h"
+#include "Netlist.h"
+#include <string>
+#include <vector>
+
+// Static compaction of an ATPG result set.
+//
+// 1. Cube merging: PODEM leaves every PI it never needed at X, so two
+//    vectors that never disagree on a specified bit can be combined.
+//    Assigning an X never takes a D away from a PO, so the merged
+//    pattern still detects everything both cubes did.
+// 2. Reverse-order fault simulation: patterns are simulated last to
+//    first with fault dropping, and any pattern that detects nothing not
+//    already detected by a later one is removed. Later patterns come
+//    from merging the sparse cubes and tend to detect the most.
+class PatternCompactor {
+public:
+    explicit PatternCompactor(const Netlist& n);
+
+    // lines[i] is the ATPG output line for faults[i]; only vector lines
+    // (one 0/1/X per PI) contribute cubes
+    void compact(const std::vector<FaultSpec>& faults, const std::vector<std::string>& lines);
+
+    size_t getCubeCount() const { return cubeCount; }
+    size_t getMergedCount() const { return mergedCount; }
+    const std::vector<std::string>& getPatterns() const { return patterns; }
+
+    // Index into getPatterns() of the pattern credited with detecting
+    // each fault, -1 if none does
+    const std::vector<int>& getFaultPatterns() const { return faultPattern; }
+
+private:
+    std::vector<std::string> mergeCubes(const std::vector<std::string>& cubes) const;
+
+    const Netlist& netlist;
+    size_t cubeCount;
+    size_t mergedCount;
+    std::vector<std::string> patterns;
+    std::vector<int> faultPattern;
+};
+
+#endif // PATTERN_COMPACTOR_H
@@ -0,0 +1,131 @@
+#include "PatternFile.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+
+static const char PATTERN_MAGIC[8] = {'P', 'O', 'D', 'E', 'M', 'P', 'T', '\0'};
+static const uint32_t PATTERN_VERSION = 1;
+
+enum : unsigned char { CODE_X = 0, CODE_ZERO = 1, CODE_ONE = 2 };
+
+static size_t roundUp8(size_t n) {
+    return (n + 7) & ~size_t(7);
+}
+
+// --- PatternWriter ---
+
+PatternWriter::PatternWriter(const Netlist& n) : netlist(n) {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PATTERN_MAGIC, sizeof(PATTERN_MAGIC));
+    header.version = PATTERN_VERSION;
+    header.byteOrder = 0x01020304;
+    header.piCount = netlist.getPIs().size();
+    header.patternBytes = roundUp8((header.piCount + 3) / 4);
+    for (int pi : netlist.getPIs()) {
+        header.namesBytes += netlist.getName(pi).size() + 1;
+    }
+    header.dataOffset = roundUp8(sizeof(PatternFileHeader) + header.namesBytes);
+    packed.resize(header.patternBytes);
+}
+
+bool PatternWriter::open(const std::string& path) {
+    static_assert(sizeof(PatternFileHeader) % 8 == 0, "names must start 8-byte aligned");
+    out.open(path, std::ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    writeHeader();
+    for (int pi : netlist.getPIs()) {
+        out << netlist.getName(pi) << '\n';
+    }
+    std::string padding(header.dataOffset - sizeof(PatternFileHeader) - header.namesBytes, '\0');
+    out.write(padding.data(), padding.size());
+    return bool(out);
+}
+
+void PatternWriter::writeHeader() {
+    header.patternCount = patternCount;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void PatternWriter::add(std::string_view vector) {
+    if (vector.size() != header.piCount || vector.find_first_not_of("01X") != std::string_view::npos) {
+        return;
+    }
+    std::fill(packed.begin(), packed.end(), '\0');
+    for (size_t i = 0; i < vector.size(); ++i) {
+        unsigned char code = (vector[i] == '1') ? CODE_ONE : (vector[i] == '0') ? CODE_ZERO : CODE_X;
+        packed[i / 4] = char(packed[i / 4] | code << (2 * (i % 4)));
+    }
+    if (!seen.insert(packed).second) {
+        return;
+    }
+    out.write(packed.data(), packed.size());
+    patternCount++;
+}
+
+bool PatternWriter::close() {
+    out.seekp(0);
+    writeHeader();
+    out.close();
+    return !out.fail();
+}
+
+// --- PatternReader ---
+
+PatternReader::PatternReader() = default;
+PatternReader::~PatternReader() = default;
+
+bool PatternReader::isPatternFile(const std::string& path) {
+    MappedFile mapped(path);
+    return mapped.isOpen() && mapped.size() >= sizeof(PATTERN_MAGIC) &&
+           std::memcmp(mapped.data(), PATTERN_MAGIC, sizeof(PATTERN_MAGIC)) == 0;
+}
+
+bool PatternReader::open(const std::string& path, const Netlist& netlist) {
+    file = std::make_unique<MappedFile>(path);
+    if (!file->isOpen() || file->size() < sizeof(PatternFileHeader)) {
+        error = "Cannot read pattern file " + path;
+        return false;
+    }
+    PatternFileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, PATTERN_MAGIC, sizeof(PATTERN_MAGIC)) != 0 || header.version != PATTERN_VERSION ||
+        header.byteOrder != 0x01020304 || header.piCount == 0 || header.patternBytes != roundUp8((header.piCount + 3) / 4) ||
+        header.dataOffset < sizeof(header) + header.namesBytes || header.dataOffset > file->size() ||
+        (file->size() - header.dataOffset) / header.patternBytes < header.patternCount) {
+        error = "Unsupported or damaged pattern file " + path;
+        return false;
+    }
+
+    // PI names, one per line, must be the circuit's PIs in order
+    std::string_view names(file->data() + sizeof(header), header.namesBytes);
+    size_t i = 0;
+    for (int pi : netlist.getPIs()) {
+        size_t end = names.find('\n');
+        if (end == std::string_view::npos || names.substr(0, end) != netlist.getName(pi)) {
+            break;
+        }
+        names.remove_prefix(end + 1);
+        i++;
+    }
+    if (i != netlist.getPIs().size() || header.piCount != i || !names.empty()) {
+        error = "PIs in pattern file " + path + " do not match the circuit";
+        return false;
+    }
+
+    piCount = header.piCount;
+    patternCount = header.patternCount;
+    patternBytes = header.patternBytes;
+    data = reinterpret_cast<const unsigned char*>(file->data() + header.dataOffset);
+    return true;
+}
+
+void PatternReader::getPattern(size_t p, std::vector<LogicValue>& piValues) const {
+    const unsigned char* pattern = data + p * patternBytes;
+    piValues.resize(piCount);
+    for (size_t i = 0; i < piCount; ++i) {
+        unsigned code = (pattern[i / 4] >> (2 * (i % 4))) & 3;
+        piValues[i] = (code == CODE_ONE) ? LogicValue::ONE : (code == CODE_ZERO) ? LogicValue::ZERO : LogicValue::X;
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef PATTERN_FILE_H
+#define PATTERN_FILE_H
+
+#include "Netlist.h"
+#include "logic.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+class MappedFile;
+
+// Packed binary pattern file, meant to be memory-mapped by tester
+// conversion tools:
+//
+//   PatternFileHeader                     (56 bytes)
+//   PI names, each followed by '\n'       (namesBytes, then zero padding)
+//   patternCount patterns                 (from dataOffset, patternBytes each)
+//
+// A pattern holds 2 bits per PI in PI order: PI i is in byte i / 4 at bit
+// 2 * (i % 4), with 0 = X, 1 = logic 0, 2 = logic 1. dataOffset and
+// patternBytes are multiples of 8, so each pattern can also be read as
+// little-endian 64-bit words (32 PIs per word). Header fields are in the
+// writer's byte order; byteOrder tells readers which one that was.
+struct PatternFileHeader {
+    char magic[8];          // "PODEMPT"
+    uint32_t version;
+    uint32_t byteOrder;     // 0x01020304
+    uint64_t piCount;
+    uint64_t patternCount;
+    uint64_t patternBytes;
+    uint64_t namesBytes;
+    uint64_t dataOffset;
+};
+
+// Streams patterns to a file. Duplicate vectors are written once, and
+// lines that are not vectors ("none found", "aborted", ...) are ignored.
+class PatternWriter {
+public:
+    explicit PatternWriter(const Netlist& netlist);
+
+    bool open(const std::string& path);
+    void add(std::string_view vector);
+    // Fills in the final pattern count; false if any write failed
+    bool close();
+
+    size_t getPatternCount() const { return patternCount; }
+
+private:
+    void writeHeader();
+
+    const Netlist& netlist;
+    std::ofstream out;
+    PatternFileHeader header;
+    size_t patternCount = 0;
+    std::string packed;
+    std::unordered_set<std::string> seen; // Packed patterns already written
+};
+
+// Read-only view of a pattern file, mapped in place
+class PatternReader {
+public:
+    PatternReader();
+    ~PatternReader();
+
+    // Whether 'path' starts with the pattern file magic
+    static bool isPatternFile(const std::string& path);
+
+    // Fails unless the file's PIs match the netlist's, in the same order
+    bool open(const std::string& path, const Netlist& netlist);
+    const std::string& getError() const { return error; }
+
+    size_t getPatternCount() const { return patternCount; }
+    void getPattern(size_t p, std::vector<LogicValue>& piValues) const;
+
+private:
+    std::unique_ptr<MappedFile> file;
+    std::string error;
+    size_t piCount = 0;
+    size_t patternCount = 0;
+    size_t patternBytes = 0;
+    const unsigned char* data = nullptr;
+};
+
+#endif // PATTERN_FILE_H
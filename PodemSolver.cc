@@ -1,89 +1,148 @@
 #include "PodemSolver.h"
 #include "logic_util.h"
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 
-PodemSolver::PodemSolver(Circuit& c, const std::string& faultGateName, FaultType fault)
-    : circuit(c) {
+PodemSolver::PodemSolver(const Netlist& n, SimState& s, int gate, FaultType fault, bool scoap)
+    : netlist(n), state(s), faultGate(gate), useScoap(scoap), backtrackCount(0), prunedCount(0),
+      backtrackLimit(0), timeLimitMs(0), nodesSinceClockCheck(0), aborted(false) {
         
-    faultGate = circuit.getGate(faultGateName);
-    if (!faultGate) {
-        throw std::runtime_error("Fault gate not found: " + faultGateName);
+    if (faultGate < 0 || faultGate >= netlist.getGateCount()) {
+        throw std::out_of_range("Fault gate id out of range: " + std::to_string(faultGate));
     }
     
     this->faultType = fault;
     
-    circuit.setAllFaults(FaultType::NO_FAULT);
-    faultGate->setFault(fault);
+    state.setFault(faultGate, fault);
+    state.setFrontierOrder(useScoap ? SimState::FrontierOrder::OBSERVABILITY
+                                    : SimState::FrontierOrder::DECLARATION);
     
     faultActivationVal = (fault == FaultType::SA0) ? LogicValue::ONE : LogicValue::ZERO;
 }
 
-bool PodemSolver::solve(std::vector<std::pair<std::string, LogicValue>>& testVector) {
-    // Run the main recursion
-    bool success = podemRecursion();
+void PodemSolver::setLimits(long maxBacktracks, long maxMs) {
+    backtrackLimit = maxBacktracks;
+    timeLimitMs = maxMs;
+}
+
+bool PodemSolver::solve(std::vector<LogicValue>& piValues) {
+    aborted = false;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMs);
+    stats = SearchStats();
+    STATS_ONLY(auto started = std::chrono::steady_clock::now());
+    STATS_ONLY(long evaluationsBefore = state.getEvaluationCount());
+
+    // Fixed PIs go in before the full simulation, so they are part of the
+    // starting state and never on the decision stack. Backtrace only ever
+    // reaches X PIs, so the search cannot overwrite them.
+    IdRange pis = netlist.getPIs();
+    for (size_t i = 0; i < fixedPIs.size() && i < pis.size(); ++i) {
+        if (fixedPIs[i] != LogicValue::X) {
+            state.presetPI(pis[i], fixedPIs[i]);
+        }
+    }
+
+    // One full simulation establishes the starting state; after this,
+    // every decision is implied incrementally and undone via the trail.
+    state.runFullSimulation();
+
+    // Run the search
+    ruledOut = learned && !assignRequiredValues();
+    bool success = !ruledOut && search();
+    if (implicator) {
+        implicator->reset();
+        implicator = nullptr;
+    }
+    STATS_ONLY(stats.evaluations = state.getEvaluationCount() - evaluationsBefore);
 
     if (success) {
-        for (Gate* pi : circuit.getPIs()) {
-            testVector.push_back({pi->getName(), pi->getValue()});
+        piValues.clear();
+        for (int pi : pis) {
+            piValues.push_back(state.getValue(pi));
         }
     }
-    
+    STATS_ONLY(stats.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count());
     return success;
 }
 
-bool PodemSolver::podemRecursion() {
-    
-    // Run a full simulation first to get the current state
-    circuit.runFullSimulation();
+// Depth-first search over PI decisions. Each decision on the stack is
+// tried with its backtraced value first and flipped once on failure; the
+// SimState trail restores exactly the nets a decision changed. This
+// explores the same tree, in the same order, as the classic recursive
+// formulation, but depth is bounded by memory rather than the call stack.
+bool PodemSolver::search() {
+    decisions.clear();
 
-    // 1. Check if test is found (D or D-bar at a PO)
-    if (checkTest()) {
-        return true;
-    }
+    while (true) {
+        // 1. Check if test is found (D or D-bar at a PO)
+        if (checkTest()) {
+            return true;
+        }
 
-    // 2. Get the next objective
-    Gate* objectiveGate = nullptr;
-    LogicValue objectiveValue = LogicValue::UNSET;
-    if (!getObjective(objectiveGate, objectiveValue)) {
-        return false; // Backtrack: Failed to find an objective
-    }
+        // 2. Get the next objective and backtrace it to a PI
+        int objectiveGate = -1;
+        LogicValue objectiveValue = LogicValue::UNSET;
+        if (!outOfBudget() && getObjective(objectiveGate, objectiveValue)) {
+            int pi = -1;
+            LogicValue piValue = LogicValue::UNSET;
+            backtrace(objectiveGate, objectiveValue, pi, piValue);
 
-    // 3. Backtrace to find a PI to set
-    Gate* pi = nullptr;
-    LogicValue piValue = LogicValue::UNSET;
-    backtrace(objectiveGate, objectiveValue, pi, piValue);
+            // 3. Decide: try the backtraced value first
+            decisions.push_back({pi, piValue, state.getTrailMark(),
+                                 implicator ? implicator->getTrailMark() : 0, false});
+            STATS_ONLY(stats.decisions++, stats.maxDepth = std::max(stats.maxDepth, long(decisions.size())));
+            state.assignAndImply(pi, piValue);
+            if (implyDecision(pi, piValue)) {
+                continue;
+            }
+        }
 
-    // 4. Try setting the PI
-    pi->setValue(piValue);
-    circuit.runFullSimulation();
-    
-    if (podemRecursion()) {
-        return true; // Success!
+        // 4. Backtrack: undo decisions whose both values failed, then
+        // flip the newest one that still has its opposite value to try
+        while (true) {
+            if (aborted || decisions.empty()) {
+                if (!decisions.empty()) {
+                    undoDecision(decisions.front());
+                }
+                return false;
+            }
+            Decision& d = decisions.back();
+            undoDecision(d);
+            if (d.flipped) {
+                decisions.pop_back();
+                continue;
+            }
+            if (backtrackLimit > 0 && backtrackCount >= backtrackLimit) {
+                aborted = true;
+                continue;
+            }
+            backtrackCount++;
+            d.flipped = true;
+            state.assignAndImply(d.pi, logic_not(d.value));
+            if (implyDecision(d.pi, logic_not(d.value))) {
+                break;
+            }
+        }
     }
+}
 
-    // 5. Backtrack: Try the opposite value
-    // We must reset the PI to X before trying the opposite
-    pi->setValue(LogicValue::X);
-    circuit.runFullSimulation();
-    
-    pi->setValue(logic_not(piValue));
-    circuit.runFullSimulation();
-    
-    if (podemRecursion()) {
-        return true; // Success!
+// Checks the time limit. Reading the clock on every node would cost
+// more than the node itself, so it is sampled. (The backtrack limit is
+// checked where a decision is about to be flipped.)
+bool PodemSolver::outOfBudget() {
+    if (timeLimitMs > 0 && ++nodesSinceClockCheck >= 256) {
+        nodesSinceClockCheck = 0;
+        if (std::chrono::steady_clock::now() >= deadline) {
+            aborted = true;
+        }
     }
-
-    // 6. Backtrack: Failed, reset PI to X
-    pi->setValue(LogicValue::X);
-    circuit.runFullSimulation();
-    
-    return false; // Backtrack
+    return aborted;
 }
 
 bool PodemSolver::checkTest() {
-    for (Gate* po : circuit.getPOs()) {
-        LogicValue val = po->getValue(); // Just read the value
+    for (int po : netlist.getPOs()) {
+        LogicValue val = state.getValue(po); // Just read the value
         if (val == LogicValue::D || val == LogicValue::DBAR) {
             return true;
         }
@@ -91,33 +150,42 @@ bool PodemSolver::checkTest() {
     return false;
 }
 
-bool PodemSolver::getObjective(Gate*& objectiveGate, LogicValue& objectiveValue) {
+bool PodemSolver::getObjective(int& objectiveGate, LogicValue& objectiveValue) {
     // We read the value directly, since simulation was just run
-    LogicValue faultGateVal = faultGate->getValue(); 
+    LogicValue faultGateVal = state.getValue(faultGate); 
     
     // 1. Check if fault is activated
     if (faultGateVal == LogicValue::D || faultGateVal == LogicValue::DBAR) {
-        // 2. Propagate: Find D-Frontier
-        updateDFrontier();
-        
-        if (dFrontier.empty()) {
+        // 2. Propagate: the implication engine keeps the D-frontier current
+        if (state.isDFrontierEmpty()) {
             return false; // Backtrack: Fault is activated but cannot be propagated
         }
+        if (!state.dFrontierHasXPath()) {
+            prunedCount++;
+            return false; // Backtrack: Every path to a PO is already blocked
+        }
         
+        STATS_ONLY(stats.frontierSamples++, stats.frontierTotal += state.getDFrontierSize(),
+                   stats.frontierMax = std::max(stats.frontierMax, long(state.getDFrontierSize())));
+
         // 3. Find objective from D-frontier
-        Gate* dGate = findEasiestDFrontierGate(); 
+        int dGate = findEasiestDFrontierGate(); 
         
-        for (Gate* input : dGate->getInputs()) {
-            if (input->getValue() == LogicValue::X) {
+        for (int input : netlist.getInputs(dGate)) {
+            if (state.getValue(input) == LogicValue::X) {
                 objectiveGate = input;
                 // THIS IS THE FIX: We need the NON-controlling value
-                objectiveValue = getNonControllingValue(dGate->getType());
+                objectiveValue = getNonControllingValue(netlist.getType(dGate));
                 return true;
             }
         }
     }
 
     // 4. Check if fault is *not* active (value is X or the value needed for activation)
+    if (faultGateVal == LogicValue::X && !state.hasXPath(faultGate)) {
+        prunedCount++;
+        return false; // Backtrack: Activating the fault could never reach a PO
+    }
     if (faultGateVal == LogicValue::X || faultGateVal == faultActivationVal) {
         objectiveGate = faultGate;
         objectiveValue = faultActivationVal;
@@ -129,62 +197,116 @@ bool PodemSolver::getObjective(Gate*& objectiveGate, LogicValue& objectiveValue)
     return false;
 }
 
-void PodemSolver::updateDFrontier() {
-    dFrontier.clear();
-    for (auto& g_ptr : circuit.getAllGates()) {
-        Gate* g = g_ptr.get();
-        // A gate is on the D-frontier if its output is X
-        if (g->getValue() == LogicValue::X) {
-            // And at least one of its inputs is D or D-bar
-            for (Gate* input : g->getInputs()) {
-                if (input->getValue() == LogicValue::D || input->getValue() == LogicValue::DBAR) {
-                    dFrontier.push_back(g);
-                    break;
-                }
-            }
+// Every test activates the fault and sensitizes its dominators, so
+// everything those values imply in the fault-free circuit, directly or
+// through learned implications, must hold as well. Fixed PIs go on top.
+// Returns false if that is contradictory.
+bool PodemSolver::assignRequiredValues() {
+    implicator = &state.getImplicator();
+    implicator->reset();
+    int activationValue = (faultActivationVal == LogicValue::ONE) ? 1 : 0;
+    if (!implicator->assignTestRequirements(faultGate, activationValue, learned)) {
+        return false;
+    }
+    IdRange pis = netlist.getPIs();
+    for (size_t i = 0; i < fixedPIs.size() && i < pis.size(); ++i) {
+        if (fixedPIs[i] != LogicValue::X &&
+            !implicator->assign(makeLiteral(pis[i], fixedPIs[i] == LogicValue::ONE ? 1 : 0), learned)) {
+            return false;
         }
     }
+    return true;
+}
+
+// Adds a decision to the learned-implication state. A conflict means no
+// test extends the current decisions.
+bool PodemSolver::implyDecision(int pi, LogicValue value) {
+    if (!implicator || implicator->assign(makeLiteral(pi, value == LogicValue::ONE ? 1 : 0), learned)) {
+        return true;
+    }
+    learnedPrunedCount++;
+    return false;
+}
+
+void PodemSolver::undoDecision(const Decision& d) {
+    state.undoToMark(d.trailMark);
+    if (implicator) {
+        implicator->undoToMark(d.implicationMark);
+    }
+}
+
+int PodemSolver::findEasiestDFrontierGate() {
+    // The frontier is ordered by declaration rank, or by CO under SCOAP
+    // guidance, so the easiest gate is always its first member
+    return state.getFirstDFrontierGate();
 }
 
-Gate* PodemSolver::findEasiestDFrontierGate() {
-    if (!dFrontier.empty()) {
-        return dFrontier[0];
+// Chooses which X input of 'gate' the backtrace follows, given the value
+// that input must take. If one input at that value settles the gate (a
+// controlling value), take the easiest one; if every input needs it, take
+// the hardest so an impossible objective fails before effort is spent on
+// the rest. Returns -1 if no input is X.
+int PodemSolver::pickBacktraceInput(int gate, LogicValue inputValue) {
+    IdRange inputs = netlist.getInputs(gate);
+    int chosen = -1;
+
+    if (!useScoap) {
+        for (int input : inputs) {
+            if (state.getValue(input) == LogicValue::X) {
+                return input;
+            }
+        }
+        return chosen;
+    }
+
+    GateType type = netlist.getType(gate);
+    bool needsAll = (type == GateType::AND || type == GateType::NAND ||
+                     type == GateType::OR || type == GateType::NOR) &&
+                    inputValue != getControllingValue(type);
+    for (int input : inputs) {
+        if (state.getValue(input) != LogicValue::X) {
+            continue;
+        }
+        if (chosen < 0) {
+            chosen = input;
+            continue;
+        }
+        int cost = netlist.getCC(input, inputValue);
+        int chosenCost = netlist.getCC(chosen, inputValue);
+        if (needsAll ? (cost > chosenCost) : (cost < chosenCost)) {
+            chosen = input;
+        }
     }
-    return nullptr;
+    return chosen;
 }
 
-void PodemSolver::backtrace(Gate* objectiveGate, LogicValue objectiveValue, 
-                           Gate*& pi, LogicValue& piValue) {
+void PodemSolver::backtrace(int objectiveGate, LogicValue objectiveValue, 
+                           int& pi, LogicValue& piValue) {
     
-    Gate* currentGate = objectiveGate;
+    int currentGate = objectiveGate;
     LogicValue currentValue = objectiveValue;
 
-    while (currentGate->getType() != GateType::PI) {
+    while (netlist.getType(currentGate) != GateType::PI) {
+        IdRange inputs = netlist.getInputs(currentGate);
         
-        if (currentGate->getType() == GateType::FANOUT) {
-             currentGate = currentGate->getInputs()[0];
+        if (netlist.getType(currentGate) == GateType::FANOUT) {
+             currentGate = inputs[0];
              continue;
         }
 
-        Gate* nextGate = nullptr;
-        for (Gate* input : currentGate->getInputs()) {
-            if (input->getValue() == LogicValue::X) {
-                nextGate = input;
-                break;
-            }
+        if (isInvertingGate(netlist.getType(currentGate))) {
+            currentValue = logic_not(currentValue);
         }
+
+        int nextGate = pickBacktraceInput(currentGate, currentValue);
         
-        if (!nextGate && !currentGate->getInputs().empty()) {
-            nextGate = currentGate->getInputs()[0];
+        if (nextGate < 0 && !inputs.empty()) {
+            nextGate = inputs[0];
         }
 
-        if (!nextGate) {
+        if (nextGate < 0) {
              throw std::runtime_error("Backtrace hit a dead end");
         }
-
-        if (isInvertingGate(currentGate->getType())) {
-            currentValue = logic_not(currentValue);
-        }
         
         currentGate = nextGate;
     }
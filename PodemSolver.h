@@ -1,40 +1,116 @@
 #ifndef PODEM_SOLVER_H
 #define PODEM_SOLVER_H
 
-#include "Circuit.h"
+#include "Netlist.h"
+#include "SearchStats.h"
+#include "SimState.h"
+#include "StaticLearning.h"
 #include "logic.h"
+#include <chrono>
 #include <vector>
 
 class PodemSolver {
 public:
     // Constructor
-    PodemSolver(Circuit& c, const std::string& faultGateName, FaultType fault);
+    // The solver only reads the netlist; all values live in 'state'.
+    // With useScoap, backtrace and D-frontier selection follow the
+    // netlist's SCOAP measures instead of taking the first candidate.
+    // 'faultGate' is a Netlist id (see Netlist::findGate).
+    PodemSolver(const Netlist& n, SimState& state, int faultGate, FaultType fault, bool useScoap = false);
 
-    // Main function to run the algorithm
-    bool solve(std::vector<std::pair<std::string, LogicValue>>& testVector);
+    // Per-fault search budget; 0 means unlimited. When a limit is hit,
+    // solve() gives up and returns false with wasAborted() set.
+    void setLimits(long backtrackLimit, long timeLimitMs);
+
+    // PI values (in Netlist::getPIs() order) the search must keep; X
+    // entries stay free. Used to extend an existing test cube.
+    void setFixedPIs(const std::vector<LogicValue>& piValues) { fixedPIs = piValues; }
+
+    // With learned implications, solve() first derives every value the
+    // fault-free circuit must have in any test (see
+    // Implicator::assignTestRequirements). Each decision is then implied
+    // on top of those values, learned implications included, and the
+    // search backtracks as soon as they conflict.
+    void setLearnedImplications(const LearnedImplications* table) { learned = table; }
+
+    // Main function to run the algorithm. On success, 'piValues' holds
+    // one value per PI in Netlist::getPIs() order.
+    bool solve(std::vector<LogicValue>& piValues);
+
+    // True if the last solve() ran out of budget, i.e. "no test found"
+    // does not prove the fault untestable
+    bool wasAborted() const { return aborted; }
+
+    // Decisions that had to be flipped to their opposite value
+    long getBacktrackCount() const { return backtrackCount; }
+
+    // Search nodes abandoned early because no X-path to a PO was left
+    long getPrunedCount() const { return prunedCount; }
+
+    // Decisions abandoned because they conflict with a value every test
+    // needs (see setLearnedImplications)
+    long getLearnedPrunedCount() const { return learnedPrunedCount; }
+    // True if the last solve() found the required values inconsistent, so
+    // the fault is untestable (or, with fixed PIs, no test keeps them)
+    // without any search
+    bool wasRuledOutByLearning() const { return ruledOut; }
+
+    // Decisions, depth, gate evaluations, D-frontier sizes and time of
+    // the last solve(); all zero unless built with PODEM_STATS
+    const SearchStats& getStats() const { return stats; }
 
 private:
     // --- Core PODEM Functions ---
-    bool podemRecursion();
+    bool search();
+    bool outOfBudget();
     
-    bool getObjective(Gate*& objectiveGate, LogicValue& objectiveValue);
+    bool getObjective(int& objectiveGate, LogicValue& objectiveValue);
     
-    void backtrace(Gate* objectiveGate, LogicValue objectiveValue, 
-                   Gate*& pi, LogicValue& piValue);
-                   
-    void updateDFrontier();
+    void backtrace(int objectiveGate, LogicValue objectiveValue, 
+                   int& pi, LogicValue& piValue);
 
     // --- State Variables ---
-    Circuit& circuit;
-    Gate* faultGate;
+    const Netlist& netlist;
+    SimState& state;
+    int faultGate;
     FaultType faultType;
     LogicValue faultActivationVal;
-    
-    std::vector<Gate*> dFrontier;
+    bool useScoap;
+    std::vector<LogicValue> fixedPIs;
+    long backtrackCount;
+    long prunedCount;
+    SearchStats stats;
+
+    // --- Static Learning ---
+    const LearnedImplications* learned = nullptr;
+    Implicator* implicator = nullptr; // The state's, while solve() runs
+    long learnedPrunedCount = 0;
+    bool ruledOut = false;
+    bool assignRequiredValues();
+    bool implyDecision(int pi, LogicValue value);
+
+    // One PI assignment on the search path
+    struct Decision {
+        int pi;
+        LogicValue value;  // Value tried first
+        size_t trailMark;  // Trail position before the assignment
+        size_t implicationMark; // Same for the learned-implication state
+        bool flipped;      // Whether the opposite value is being tried now
+    };
+    std::vector<Decision> decisions;
+    void undoDecision(const Decision& d);
+
+    // --- Budget ---
+    long backtrackLimit;
+    long timeLimitMs;
+    std::chrono::steady_clock::time_point deadline;
+    long nodesSinceClockCheck;
+    bool aborted;
 
     // --- Helper Functions ---
     bool checkTest();
-    Gate* findEasiestDFrontierGate();
+    int findEasiestDFrontierGate();
+    int pickBacktraceInput(int gate, LogicValue inputValue);
     
     // Helper for backtrace
     LogicValue getControllingValue(GateType type);
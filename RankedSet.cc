@@ -0,0 +1,54 @@
+#include "RankedSet.h"
+#include <algorithm>
+
+void RankedSet::reset(int size) {
+    levels.clear();
+    size_t words = std::max(1, (size + 63) / 64);
+    levels.emplace_back(words, 0);
+    while (words > 1) {
+        words = (words + 63) / 64;
+        levels.emplace_back(words, 0);
+    }
+}
+
+void RankedSet::clear() {
+    for (auto& level : levels) {
+        std::fill(level.begin(), level.end(), 0);
+    }
+}
+
+void RankedSet::insert(int rank) {
+    size_t index = rank;
+    for (auto& level : levels) {
+        uint64_t& word = level[index >> 6];
+        bool wasEmpty = (word == 0);
+        word |= uint64_t(1) << (index & 63);
+        if (!wasEmpty) {
+            break; // The summary bits above are already set
+        }
+        index >>= 6;
+    }
+}
+
+void RankedSet::erase(int rank) {
+    size_t index = rank;
+    for (auto& level : levels) {
+        uint64_t& word = level[index >> 6];
+        word &= ~(uint64_t(1) << (index & 63));
+        if (word != 0) {
+            break; // Still non-empty, so the summary bits stay
+        }
+        index >>= 6;
+    }
+}
+
+int RankedSet::first() const {
+    if (empty()) {
+        return -1;
+    }
+    size_t index = 0;
+    for (size_t k = levels.size(); k-- > 0;) {
+        index = (index << 6) | __builtin_ctzll(levels[k][index]);
+    }
+    return index;
+}
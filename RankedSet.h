@@ -0,0 +1,32 @@
+#ifndef RANKED_SET_H
+#define RANKED_SET_H
+
+#include <cstdint>
+#include <vector>
+
+// Set of integers in [0, size) with O(1) insert/erase and a find-first
+// that reads one word per level of a 64-ary summary tree (two or three
+// words for any realistic netlist). Used for the D-frontier, where a
+// gate's rank is its position in the selection order.
+class RankedSet {
+public:
+    void reset(int size);
+    void clear();
+
+    void insert(int rank);
+    void erase(int rank);
+    bool contains(int rank) const {
+        return (levels[0][rank >> 6] >> (rank & 63)) & 1;
+    }
+    bool empty() const { return levels.back()[0] == 0; }
+
+    // Smallest member, or -1 if the set is empty
+    int first() const;
+
+private:
+    // levels[0] has one bit per rank; bit i of levels[k+1] is set
+    // when word i of levels[k] is non-zero. The last level is one word.
+    std::vector<std::vector<uint64_t>> levels;
+};
+
+#endif // RANKED_SET_H
@@ -0,0 +1,34 @@
+#include "ResultWriter.h"
+#include "PatternFile.h"
+
+const size_t ResultWriter::BUFFER_BYTES;
+
+ResultWriter::ResultWriter(std::ostream& o, PatternWriter* p) : out(o), patterns(p) {
+    buffer.reserve(BUFFER_BYTES);
+}
+
+ResultWriter::~ResultWriter() {
+    flush();
+}
+
+void ResultWriter::writeLine(std::string_view line) {
+    if (buffer.size() + line.size() >= BUFFER_BYTES) {
+        flush();
+    }
+    buffer.append(line);
+    buffer.push_back('\n');
+    if (patterns) {
+        patterns->add(line);
+    }
+    if (lineFlush) {
+        flush();
+        out.flush();
+    }
+}
+
+void ResultWriter::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
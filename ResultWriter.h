@@ -0,0 +1,38 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+class PatternWriter;
+
+// Line writer for the per-fault output. Whole lines are appended to an
+// in-memory buffer that goes to the stream in one write once it fills up,
+// so nothing is flushed per fault. Vector lines can also be copied to a
+// binary pattern file.
+class ResultWriter {
+public:
+    static const size_t BUFFER_BYTES = 1 << 20;
+
+    explicit ResultWriter(std::ostream& out, PatternWriter* patterns = nullptr);
+    ~ResultWriter();
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    // Appends 'line' and a newline
+    void writeLine(std::string_view line);
+    // Hands everything buffered so far to the stream (without flushing it)
+    void flush();
+    // Writes and flushes every line as it comes, for a client waiting on
+    // each result (the ATPG server)
+    void setLineFlush(bool on) { lineFlush = on; }
+
+private:
+    std::ostream& out;
+    PatternWriter* patterns;
+    std::string buffer;
+    bool lineFlush = false;
+};
+
+#endif // RESULT_WRITER_H
@@ -0,0 +1,114 @@
+#include "SearchStats.h"
+#include <algorithm>
+#include <iomanip>
+
+const size_t StatsReport::MAX_SLOWEST;
+
+void SearchStats::add(const SearchStats& other) {
+    decisions += other.decisions;
+    maxDepth = std::max(maxDepth, other.maxDepth);
+    evaluations += other.evaluations;
+    frontierSamples += other.frontierSamples;
+    frontierTotal += other.frontierTotal;
+    frontierMax = std::max(frontierMax, other.frontierMax);
+    timeMs += other.timeMs;
+}
+
+bool StatsReport::open(const std::string& path) {
+    json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    file.open(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    if (json) {
+        file << "[";
+    } else {
+        file << "fault,value,pass,status,time_us,decisions,backtracks,pruned,max_depth,"
+                "evaluations,frontier_avg,frontier_max\n";
+    }
+    return true;
+}
+
+void StatsReport::record(const std::string& gateName, int value, int pass, const char* status,
+                         long faultBacktracks, long faultPruned, const SearchStats& stats) {
+    double timeUs = stats.timeMs * 1000;
+    double frontierAvg = stats.frontierSamples ? double(stats.frontierTotal) / stats.frontierSamples : 0;
+    if (json) {
+        file << (rows ? ",\n" : "\n") << "{\"fault\": \"" << gateName << "\", \"value\": " << value
+             << ", \"pass\": " << pass << ", \"status\": \"" << status << "\", \"time_us\": " << timeUs
+             << ", \"decisions\": " << stats.decisions << ", \"backtracks\": " << faultBacktracks
+             << ", \"pruned\": " << faultPruned << ", \"max_depth\": " << stats.maxDepth
+             << ", \"evaluations\": " << stats.evaluations << ", \"frontier_avg\": " << frontierAvg
+             << ", \"frontier_max\": " << stats.frontierMax << "}";
+    } else {
+        file << gateName << "," << value << "," << pass << "," << status << "," << timeUs << ","
+             << stats.decisions << "," << faultBacktracks << "," << faultPruned << "," << stats.maxDepth << ","
+             << stats.evaluations << "," << frontierAvg << "," << stats.frontierMax << "\n";
+    }
+    rows++;
+
+    if (std::string(status) == "dropped") {
+        return;
+    }
+    runs++;
+    backtracks += faultBacktracks;
+    pruned += faultPruned;
+    totals.add(stats);
+    times.push_back(stats.timeMs);
+
+    // Keep the slowest runs in a min-heap, so the fastest of them is the
+    // one to replace
+    auto faster = [](const Slow& a, const Slow& b) { return a.timeMs > b.timeMs; };
+    if (slowest.size() < MAX_SLOWEST || stats.timeMs > slowest.front().timeMs) {
+        if (slowest.size() == MAX_SLOWEST) {
+            std::pop_heap(slowest.begin(), slowest.end(), faster);
+            slowest.pop_back();
+        }
+        slowest.push_back({stats.timeMs, gateName + "/" + std::to_string(value)});
+        std::push_heap(slowest.begin(), slowest.end(), faster);
+    }
+}
+
+bool StatsReport::close() {
+    if (json) {
+        file << "\n]\n";
+    }
+    file.close();
+    return !file.fail();
+}
+
+void StatsReport::writeSummary(std::ostream& out, size_t count) const {
+    out << "Search statistics: " << runs << " PODEM runs, " << totals.decisions << " decisions, "
+        << backtracks << " backtracks, " << pruned << " pruned, " << totals.evaluations
+        << " gate evaluations, deepest decision stack " << totals.maxDepth << std::endl;
+    if (runs == 0) {
+        return;
+    }
+    double frontierAvg = totals.frontierSamples ? double(totals.frontierTotal) / totals.frontierSamples : 0;
+    out << "D-frontier size: average " << std::fixed << std::setprecision(1) << frontierAvg << ", max "
+        << totals.frontierMax << std::endl;
+
+    std::vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double q) {
+        size_t rank = std::max<size_t>(1, size_t(q * sorted.size() + 0.999999));
+        return sorted[std::min(rank, sorted.size()) - 1];
+    };
+    out << std::setprecision(3) << "Time per fault (ms): p50 " << percentile(0.50) << ", p90 "
+        << percentile(0.90) << ", p99 " << percentile(0.99) << ", max " << sorted.back() << ", total "
+        << totals.timeMs << std::endl;
+
+    std::vector<Slow> top = slowest;
+    std::sort(top.begin(), top.end(), [](const Slow& a, const Slow& b) { return a.timeMs > b.timeMs; });
+    top.resize(std::min(top.size(), count));
+    if (!top.empty()) {
+        out << "Slowest faults:" << std::endl;
+        for (const Slow& s : top) {
+            double share = totals.timeMs > 0 ? 100 * s.timeMs / totals.timeMs : 0;
+            out << "  " << s.fault << ": " << s.timeMs << " ms (" << std::setprecision(1) << share
+                << "% of the total)" << std::setprecision(3) << std::endl;
+        }
+    }
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
@@ -0,0 +1,66 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <cstddef>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Search counters are compiled in only when PODEM_STATS is defined (the
+// CMake option of the same name, on by default). Without it every
+// STATS_ONLY(...) statement disappears and the counters stay zero.
+#ifdef PODEM_STATS
+#define STATS_ONLY(...) __VA_ARGS__
+#else
+#define STATS_ONLY(...) ((void)0)
+#endif
+
+// What one PodemSolver::solve() call did. Backtracks and pruned nodes
+// are always counted (see PodemSolver) and are not repeated here.
+struct SearchStats {
+    long decisions = 0;       // PI assignments, not counting flips
+    long maxDepth = 0;        // Deepest decision stack
+    long evaluations = 0;     // Gate evaluations, the full simulation included
+    long frontierSamples = 0; // Propagation objectives...
+    long frontierTotal = 0;   // ...and the D-frontier size summed over them
+    long frontierMax = 0;
+    double timeMs = 0;
+
+    // Sums counts and times, keeps the larger maximums
+    void add(const SearchStats& other);
+};
+
+// Per-fault statistics file plus the end-of-run summary. Rows go to a CSV
+// file, or to a JSON array if the path ends in ".json".
+class StatsReport {
+public:
+    bool open(const std::string& path);
+    // One PODEM run, or a fault that was dropped without one
+    void record(const std::string& gateName, int value, int pass, const char* status,
+                long backtracks, long pruned, const SearchStats& stats);
+    bool close();
+
+    // Totals, time percentiles and the 'slowest' most expensive faults
+    void writeSummary(std::ostream& out, size_t slowest) const;
+
+private:
+    struct Slow {
+        double timeMs;
+        std::string fault;
+    };
+
+    std::ofstream file;
+    bool json = false;
+    size_t rows = 0;
+
+    size_t runs = 0; // Rows with a PODEM run
+    long backtracks = 0;
+    long pruned = 0;
+    SearchStats totals;
+    std::vector<double> times; // Per PODEM run
+    std::vector<Slow> slowest; // Heap, fastest on top, at most MAX_SLOWEST
+    static const size_t MAX_SLOWEST = 100;
+};
+
+#endif // SEARCH_STATS_H
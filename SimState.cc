@@ -0,0 +1,282 @@
+#include "SimState.h"
+#include "StaticLearning.h"
+#include "logic_util.h"
+#include <algorithm>
+#include <cstring>
+
+static inline bool isFaultEffect(LogicValue v) {
+    return v == LogicValue::D || v == LogicValue::DBAR;
+}
+
+SimState::SimState(const Netlist& n)
+    : netlist(n), faultGate(-1), faultType(FaultType::NO_FAULT), pendingEvents(0),
+      frontierOrder(FrontierOrder::DECLARATION), frontierXPathCount(0) {
+    values.resize(netlist.getGateCount());
+    eventQueue.assign(netlist.getLevelCount(), {});
+    scheduled.assign(netlist.getGateCount(), false);
+    faultEffectInputs.assign(netlist.getGateCount(), 0);
+    dFrontier.reset(netlist.getGateCount());
+    xPath.assign(netlist.getGateCount(), 0);
+    countedXPath.assign(netlist.getGateCount(), 0);
+    clearAllValues();
+}
+
+SimState::~SimState() = default;
+
+Implicator& SimState::getImplicator() {
+    if (!implicator) {
+        implicator = std::make_unique<Implicator>(netlist);
+    }
+    return *implicator;
+}
+
+void SimState::setFault(int id, FaultType f) {
+    faultGate = id;
+    faultType = f;
+}
+
+void SimState::clearAllValues() {
+    trail.clear();
+    std::memcpy(values.data(), netlist.getInitialValues(), values.size() * sizeof(LogicValue));
+}
+
+// Evaluates one gate from its fanin values, dispatching on the opcode
+LogicValue SimState::evaluate(int id) const {
+    IdRange inputs = netlist.getInputs(id);
+    LogicValue good_value;
+
+    switch (netlist.getType(id)) {
+        case GateType::PI:
+            // A PI's "good value" is its own value
+            good_value = values[id];
+            break;
+        case GateType::PO:
+            // POs are just observers and don't have faults in this model
+            return inputs.empty() ? LogicValue::X : values[inputs[0]];
+        case GateType::BUFF:
+        case GateType::FANOUT:
+            good_value = inputs.empty() ? LogicValue::X : values[inputs[0]];
+            break;
+        case GateType::NOT:
+            good_value = inputs.empty() ? LogicValue::X : logic_not(values[inputs[0]]);
+            break;
+        case GateType::AND:
+            good_value = LogicValue::ONE; // Identity for AND
+            for (int in : inputs) {
+                good_value = logic_and(good_value, values[in]);
+            }
+            break;
+        case GateType::NAND:
+            good_value = LogicValue::ONE;
+            for (int in : inputs) {
+                good_value = logic_and(good_value, values[in]);
+            }
+            good_value = logic_not(good_value);
+            break;
+        case GateType::OR:
+            good_value = LogicValue::ZERO; // Identity for OR
+            for (int in : inputs) {
+                good_value = logic_or(good_value, values[in]);
+            }
+            break;
+        case GateType::NOR:
+            good_value = LogicValue::ZERO;
+            for (int in : inputs) {
+                good_value = logic_or(good_value, values[in]);
+            }
+            good_value = logic_not(good_value);
+            break;
+        case GateType::XOR:
+            good_value = LogicValue::ZERO; // Identity for XOR
+            for (int in : inputs) {
+                good_value = logic_xor(good_value, values[in]);
+            }
+            break;
+        case GateType::XNOR:
+            good_value = LogicValue::ZERO;
+            for (int in : inputs) {
+                good_value = logic_xor(good_value, values[in]);
+            }
+            good_value = logic_not(good_value);
+            break;
+        default:
+            good_value = LogicValue::X;
+            break;
+    }
+    return (id == faultGate) ? applyFault(good_value, faultType) : good_value;
+}
+
+// Runs a full simulation; ids are already in topological order
+void SimState::runFullSimulation() {
+    for (int id = 0; id < netlist.getSimulationCount(); ++id) {
+        values[id] = evaluate(id);
+    }
+    STATS_ONLY(evaluationCount += netlist.getSimulationCount());
+
+    // Rebuild the D-frontier from scratch; from here on setValue keeps it current
+    std::fill(faultEffectInputs.begin(), faultEffectInputs.end(), 0);
+    dFrontier.clear();
+    STATS_ONLY(frontierSize = 0);
+    for (int id = 0; id < netlist.getGateCount(); ++id) {
+        if (isFaultEffect(values[id])) {
+            for (int out : netlist.getOutputs(id)) {
+                faultEffectInputs[out]++;
+            }
+        }
+    }
+    // X-paths from the POs backwards: fanouts always have higher ids,
+    // and gates past the simulation count are never X
+    std::fill(countedXPath.begin(), countedXPath.end(), 0);
+    frontierXPathCount = 0;
+    for (int id = netlist.getGateCount() - 1; id >= 0; --id) {
+        xPath[id] = computeXPath(id);
+    }
+    for (int id = 0; id < netlist.getGateCount(); ++id) {
+        updateFrontierMembership(id);
+    }
+}
+
+// Event-driven counterpart of runFullSimulation for a single PI change.
+// Assumes the state is already consistent (a full simulation has run).
+void SimState::assignAndImply(int pi, LogicValue val) {
+    if (netlist.getLevel(pi) < 0) {
+        return; // Not part of the levelized circuit
+    }
+    trail.push_back({pi, values[pi]});
+    setValue(pi, val);
+
+    // The PI applies its own fault on top of the assigned value
+    LogicValue faultyVal = evaluate(pi);
+    if (faultyVal != val) {
+        trail.push_back({pi, val});
+        setValue(pi, faultyVal);
+    }
+    scheduleFanout(pi);
+
+    for (size_t lvl = netlist.getLevel(pi) + 1; lvl < eventQueue.size() && pendingEvents > 0; ++lvl) {
+        // Fanouts always sit on a higher level, so this bucket can't grow
+        for (int g : eventQueue[lvl]) {
+            scheduled[g] = false;
+            pendingEvents--;
+            STATS_ONLY(evaluationCount++);
+            LogicValue newVal = evaluate(g);
+            if (newVal != values[g]) {
+                trail.push_back({g, values[g]});
+                setValue(g, newVal);
+                scheduleFanout(g);
+            }
+        }
+        eventQueue[lvl].clear();
+    }
+}
+
+void SimState::scheduleFanout(int id) {
+    for (int out : netlist.getOutputs(id)) {
+        if (!scheduled[out] && netlist.getLevel(out) >= 0) {
+            scheduled[out] = true;
+            eventQueue[netlist.getLevel(out)].push_back(out);
+            pendingEvents++;
+        }
+    }
+}
+
+void SimState::undoToMark(size_t mark) {
+    while (trail.size() > mark) {
+        setValue(trail.back().first, trail.back().second);
+        trail.pop_back();
+    }
+}
+
+// --- D-Frontier ---
+void SimState::setValue(int id, LogicValue val) {
+    LogicValue old = values[id];
+    values[id] = val;
+
+    // A D appearing or disappearing here changes the fanout's membership
+    if (isFaultEffect(old) != isFaultEffect(val)) {
+        int delta = isFaultEffect(val) ? 1 : -1;
+        for (int out : netlist.getOutputs(id)) {
+            faultEffectInputs[out] += delta;
+            updateFrontierMembership(out);
+        }
+    }
+    // ...and this gate turning X or non-X changes its own, and may open
+    // or close X-paths through it
+    if ((old == LogicValue::X) != (val == LogicValue::X)) {
+        updateFrontierMembership(id);
+        updateXPath(id);
+    }
+}
+
+void SimState::updateFrontierMembership(int id) {
+    bool member = values[id] == LogicValue::X && faultEffectInputs[id] > 0;
+    int rank = getFrontierRank(id);
+    if (member != dFrontier.contains(rank)) {
+        if (member) {
+            dFrontier.insert(rank);
+            STATS_ONLY(frontierSize++);
+        } else {
+            dFrontier.erase(rank);
+            STATS_ONLY(frontierSize--);
+        }
+        updateFrontierXPath(id);
+    }
+}
+
+int SimState::getFrontierRank(int id) const {
+    return (frontierOrder == FrontierOrder::DECLARATION) ? netlist.getDeclarationRank(id)
+                                                         : netlist.getObservabilityRank(id);
+}
+
+int SimState::getFirstDFrontierGate() const {
+    int rank = dFrontier.first();
+    if (rank < 0) {
+        return -1;
+    }
+    return (frontierOrder == FrontierOrder::DECLARATION) ? netlist.getDeclarationOrder()[rank]
+                                                         : netlist.getObservabilityOrder()[rank];
+}
+
+// --- X-Path ---
+bool SimState::computeXPath(int id) const {
+    if (values[id] != LogicValue::X) {
+        return false;
+    }
+    if (netlist.getType(id) == GateType::PO) {
+        return true;
+    }
+    for (int out : netlist.getOutputs(id)) {
+        if (xPath[out]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Recomputes one gate and, for every gate that flipped, walks back
+// through its fanin. A worklist rather than recursion, since a flip can
+// travel back through the whole depth of the circuit.
+void SimState::updateXPath(int id) {
+    xPathWork.push_back(id);
+    while (!xPathWork.empty()) {
+        int g = xPathWork.back();
+        xPathWork.pop_back();
+        bool x = computeXPath(g);
+        if (x == static_cast<bool>(xPath[g])) {
+            continue;
+        }
+        xPath[g] = x;
+        updateFrontierXPath(g);
+        for (int in : netlist.getInputs(g)) {
+            xPathWork.push_back(in);
+        }
+    }
+}
+
+void SimState::updateFrontierXPath(int id) {
+    bool counted = xPath[id] && dFrontier.contains(getFrontierRank(id));
+    if (counted != static_cast<bool>(countedXPath[id])) {
+        countedXPath[id] = counted;
+        frontierXPathCount += counted ? 1 : -1;
+    }
+}
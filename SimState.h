@@ -0,0 +1,127 @@
+#ifndef SIM_STATE_H
+#define SIM_STATE_H
+
+#include "Netlist.h"
+#include "RankedSet.h"
+#include "SearchStats.h"
+#include "logic.h"
+#include <memory>
+#include <vector>
+
+class Implicator;
+
+// Per-run logic state over a Netlist: the value of every gate, the single
+// injected fault and the implication engine. The Netlist is only read,
+// so several SimStates (e.g. one per thread) can share it.
+class SimState {
+public:
+    explicit SimState(const Netlist& n);
+    ~SimState();
+
+    const Netlist& getNetlist() const { return netlist; }
+
+    // --- Values & Fault ---
+    LogicValue getValue(int id) const { return values[id]; }
+
+    FaultType getFault(int id) const {
+        return (id == faultGate) ? faultType : FaultType::NO_FAULT;
+    }
+
+    // Only one stuck-at fault is active at a time
+    void setFault(int id, FaultType f);
+
+    // Resets PIs to X and everything else to UNSET (one bulk copy)
+    void clearAllValues();
+
+    // Gives a PI a starting value for the next runFullSimulation(); the
+    // search then treats it as fixed. Call after clearAllValues().
+    void presetPI(int pi, LogicValue val) { values[pi] = val; }
+
+    // Runs a full simulation
+    void runFullSimulation();
+
+    // --- Event-Driven Implication ---
+    // Sets a PI and re-evaluates only its fanout cone, level by level.
+    // Propagation stops at gates whose value did not change.
+    void assignAndImply(int pi, LogicValue val);
+
+    // Every value change made by assignAndImply is logged on the trail,
+    // so a backtrack can restore the exact previous state.
+    size_t getTrailMark() const { return trail.size(); }
+    void undoToMark(size_t mark);
+
+    // --- D-Frontier ---
+    // Gates whose output is X while some input carries D or DBAR. Rebuilt
+    // by runFullSimulation(), then kept up to date by every value change,
+    // including the ones undoToMark rolls back.
+    enum class FrontierOrder { DECLARATION, OBSERVABILITY };
+
+    // Takes effect at the next runFullSimulation()
+    void setFrontierOrder(FrontierOrder order) { frontierOrder = order; }
+    bool isDFrontierEmpty() const { return dFrontier.empty(); }
+
+    // Frontier gate that comes first in the frontier order, -1 if none
+    int getFirstDFrontierGate() const;
+
+    // --- X-Path ---
+    // A gate has an X-path if it is X and a chain of X gates links it to a
+    // PO. Values only ever go from X to known while a branch deepens, so a
+    // fault effect can never cross a gate that is already known: once no
+    // frontier gate has an X-path, no further assignment can yield a test.
+    // Maintained alongside the D-frontier.
+    bool hasXPath(int id) const { return xPath[id]; }
+    bool dFrontierHasXPath() const { return frontierXPathCount > 0; }
+
+    // --- Static Learning ---
+    // Fault-free implication scratch for this state's thread, created on
+    // first use (see PodemSolver::setLearnedImplications)
+    Implicator& getImplicator();
+
+    // --- Statistics ---
+    // Kept only in PODEM_STATS builds, zero otherwise
+    long getEvaluationCount() const { return evaluationCount; }
+    int getDFrontierSize() const { return frontierSize; }
+
+private:
+    LogicValue evaluate(int id) const;
+    void scheduleFanout(int id);
+
+    // Every value write after runFullSimulation() goes through here
+    void setValue(int id, LogicValue val);
+    void updateFrontierMembership(int id);
+    int getFrontierRank(int id) const;
+    bool computeXPath(int id) const;
+    void updateXPath(int id);
+    void updateFrontierXPath(int id);
+
+    const Netlist& netlist;
+
+    std::vector<LogicValue> values; // Indexed by gate id
+    int faultGate;
+    FaultType faultType;
+
+    // One bucket of pending gates per topological level
+    std::vector<std::vector<int>> eventQueue;
+    std::vector<bool> scheduled; // Indexed by gate id
+    int pendingEvents;
+
+    // (gate id, previous value) pairs, newest last
+    std::vector<std::pair<int, LogicValue>> trail;
+
+    // Number of fanins carrying D or DBAR, indexed by gate id
+    std::vector<int> faultEffectInputs;
+    RankedSet dFrontier; // Holds frontier ranks, not ids
+    FrontierOrder frontierOrder;
+
+    std::vector<char> xPath;            // Indexed by gate id
+    std::vector<char> countedXPath;     // Frontier gate with an X-path, included below
+    int frontierXPathCount;
+    std::vector<int> xPathWork;         // Gates to recompute in updateXPath
+
+    long evaluationCount = 0;
+    int frontierSize = 0;
+
+    std::unique_ptr<Implicator> implicator;
+};
+
+#endif // SIM_STATE_H
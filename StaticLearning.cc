@@ -0,0 +1,294 @@
+#include "StaticLearning.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <utility>
+
+namespace {
+
+// Whether b=w can only come from b's inputs, so that b=!w implies
+// nothing directly about them
+bool impliedOnlyForward(const Netlist& netlist, int b, int w) {
+    if (netlist.getInputs(b).size() < 2) {
+        return false;
+    }
+    switch (netlist.getType(b)) {
+        case GateType::AND:
+        case GateType::NOR:
+            return w == 1;
+        case GateType::NAND:
+        case GateType::OR:
+            return w == 0;
+        case GateType::XOR:
+        case GateType::XNOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+// --- Implicator ---
+Implicator::Implicator(const Netlist& n)
+    : netlist(n), values(n.getGateCount(), -1), inCone(n.getGateCount(), 0), dominator(n.getGateCount(), -1) {}
+
+void Implicator::reset() {
+    for (int literal : assigned) {
+        values[literalGate(literal)] = -1;
+    }
+    assigned.clear();
+    pending.clear();
+    queue.clear();
+}
+
+void Implicator::undoToMark(size_t mark) {
+    while (assigned.size() > mark) {
+        values[literalGate(assigned.back())] = -1;
+        assigned.pop_back();
+    }
+}
+
+bool Implicator::assign(int literal, const LearnedImplications* table) {
+    learned = table;
+    pending.push_back(literal);
+    bool consistent = true;
+    while (consistent && assigned.size() < assignLimit) {
+        if (!pending.empty()) {
+            int next = pending.back();
+            pending.pop_back();
+            consistent = set(next);
+        } else if (!queue.empty()) {
+            int gate = queue.back();
+            queue.pop_back();
+            consistent = examine(gate);
+        } else {
+            break;
+        }
+    }
+    pending.clear();
+    queue.clear();
+    return consistent;
+}
+
+bool Implicator::set(int literal) {
+    int id = literalGate(literal);
+    int value = literalValue(literal);
+    if (values[id] >= 0) {
+        return values[id] == value;
+    }
+    values[id] = int8_t(value);
+    assigned.push_back(literal);
+    queue.push_back(id);
+    for (int out : netlist.getOutputs(id)) {
+        queue.push_back(out);
+    }
+    if (learned) {
+        for (int implied : learned->get(literal)) {
+            pending.push_back(implied);
+        }
+    }
+    return true;
+}
+
+// Walks up the post-dominator tree from both gates to their first common
+// dominator. Dominators always have higher ids, the PO sink the highest.
+int Implicator::intersectDominators(int a, int b) const {
+    while (a != b) {
+        if (a < b) {
+            a = dominator[a];
+        } else {
+            b = dominator[b];
+        }
+    }
+    return a;
+}
+
+bool Implicator::assignTestRequirements(int gate, int activationValue, const LearnedImplications* table) {
+    // Collect the fanout cone; ids are topological, so walking it by
+    // descending id visits every gate after all of its fanouts
+    const int sink = netlist.getGateCount();
+    cone.clear();
+    cone.push_back(gate);
+    inCone[gate] = 1;
+    for (size_t i = 0; i < cone.size(); ++i) {
+        for (int out : netlist.getOutputs(cone[i])) {
+            if (!inCone[out] && netlist.getLevel(out) >= 0) {
+                inCone[out] = 1;
+                cone.push_back(out);
+            }
+        }
+    }
+    std::sort(cone.begin(), cone.end(), std::greater<int>());
+    for (int g : cone) {
+        int dom = (netlist.getType(g) == GateType::PO) ? sink : -1;
+        for (int out : netlist.getOutputs(g)) {
+            if (inCone[out] && dominator[out] >= 0) {
+                dom = (dom < 0) ? out : intersectDominators(dom, out);
+            }
+        }
+        dominator[g] = dom;
+    }
+
+    // A fault that reaches no PO has no test at all
+    bool consistent = dominator[gate] >= 0 && assign(makeLiteral(gate, activationValue), table);
+    for (int d = dominator[gate]; consistent && d >= 0 && d != sink; d = dominator[d]) {
+        GateType type = netlist.getType(d);
+        if (type != GateType::AND && type != GateType::NAND && type != GateType::OR && type != GateType::NOR) {
+            continue;
+        }
+        int nonControlling = (type == GateType::AND || type == GateType::NAND) ? 1 : 0;
+        for (int in : netlist.getInputs(d)) {
+            if (!inCone[in] && !(consistent = assign(makeLiteral(in, nonControlling), table))) {
+                break;
+            }
+        }
+    }
+
+    for (int g : cone) {
+        inCone[g] = 0;
+        dominator[g] = -1;
+    }
+    return consistent;
+}
+
+// Fires the forward and backward rules of one gate
+bool Implicator::examine(int gate) {
+    if (netlist.getLevel(gate) < 0) {
+        return true;
+    }
+    IdRange inputs = netlist.getInputs(gate);
+    if (inputs.empty()) {
+        return true;
+    }
+    GateType type = netlist.getType(gate);
+
+    switch (type) {
+        case GateType::PO:
+        case GateType::BUFF:
+        case GateType::FANOUT:
+        case GateType::NOT: {
+            int inv = (type == GateType::NOT) ? 1 : 0;
+            int in = inputs[0];
+            if (values[in] >= 0 && !set(makeLiteral(gate, values[in] ^ inv))) {
+                return false;
+            }
+            return values[gate] < 0 || set(makeLiteral(in, values[gate] ^ inv));
+        }
+        case GateType::AND:
+        case GateType::NAND:
+        case GateType::OR:
+        case GateType::NOR: {
+            int c = (type == GateType::AND || type == GateType::NAND) ? 0 : 1; // Controlling value
+            int inv = (type == GateType::NAND || type == GateType::NOR) ? 1 : 0;
+            bool controlled = false;
+            int xCount = 0;
+            int lastX = -1;
+            for (int in : inputs) {
+                if (values[in] == c) {
+                    controlled = true;
+                } else if (values[in] < 0) {
+                    xCount++;
+                    lastX = in;
+                }
+            }
+            if (controlled || xCount == 0) {
+                if (!set(makeLiteral(gate, (controlled ? c : 1 - c) ^ inv))) {
+                    return false;
+                }
+            }
+            if (values[gate] == ((1 - c) ^ inv)) {
+                // Every input must be non-controlling
+                for (int in : inputs) {
+                    if (!set(makeLiteral(in, 1 - c))) {
+                        return false;
+                    }
+                }
+            } else if (values[gate] == (c ^ inv) && !controlled && xCount == 1) {
+                return set(makeLiteral(lastX, c));
+            }
+            return true;
+        }
+        case GateType::XOR:
+        case GateType::XNOR: {
+            int parity = (type == GateType::XNOR) ? 1 : 0;
+            int xCount = 0;
+            int lastX = -1;
+            for (int in : inputs) {
+                if (values[in] < 0) {
+                    xCount++;
+                    lastX = in;
+                } else {
+                    parity ^= values[in];
+                }
+            }
+            if (xCount == 0) {
+                return set(makeLiteral(gate, parity));
+            }
+            if (xCount == 1 && values[gate] >= 0) {
+                return set(makeLiteral(lastX, values[gate] ^ parity));
+            }
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+// --- Learning Pre-Pass ---
+const size_t LearnedImplications::IMPLICATION_LIMIT;
+
+std::unique_ptr<LearnedImplications> LearnedImplications::learn(const Netlist& netlist, long timeLimitMs) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(timeLimitMs);
+    std::unique_ptr<LearnedImplications> result(new LearnedImplications());
+    result->totalGates = netlist.getSimulationCount();
+    Implicator implicator(netlist);
+    implicator.setAssignLimit(IMPLICATION_LIMIT);
+
+    // (from, to) literal pairs. Buffers, inverters, fanout branches and
+    // POs are equivalent to their driver, which is learned from instead.
+    std::vector<std::pair<int, int>> pairs;
+    int a = 0;
+    for (; a < netlist.getSimulationCount(); ++a) {
+        if (timeLimitMs > 0 && a % 256 == 0 && std::chrono::steady_clock::now() > deadline) {
+            break;
+        }
+        GateType type = netlist.getType(a);
+        if (type == GateType::PO || type == GateType::BUFF || type == GateType::NOT ||
+            type == GateType::FANOUT) {
+            continue;
+        }
+        for (int v = 0; v <= 1; ++v) {
+            int literal = makeLiteral(a, v);
+            implicator.reset();
+            if (!implicator.assign(literal)) {
+                pairs.push_back({literal, negateLiteral(literal)});
+                result->constants++;
+                continue;
+            }
+            for (int implied : implicator.getAssigned()) {
+                int b = literalGate(implied);
+                if (b != a && impliedOnlyForward(netlist, b, literalValue(implied))) {
+                    pairs.push_back({negateLiteral(implied), negateLiteral(literal)});
+                }
+            }
+        }
+    }
+
+    result->learnedGates = a;
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    result->offsets.assign(2 * size_t(netlist.getGateCount()) + 1, 0);
+    result->targets.reserve(pairs.size());
+    for (const auto& p : pairs) {
+        result->offsets[p.first + 1]++;
+        result->targets.push_back(p.second);
+    }
+    for (size_t i = 1; i < result->offsets.size(); ++i) {
+        result->offsets[i] += result->offsets[i - 1];
+    }
+    result->learnMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,115 @@
+#ifndef STATIC_LEARNING_H
+#define STATIC_LEARNING_H
+
+#include "Netlist.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A literal is a gate at a fixed value in the fault-free circuit:
+// 2 * id for 0, 2 * id + 1 for 1. Its negation flips the low bit.
+inline int makeLiteral(int id, int value) { return 2 * id + value; }
+inline int literalGate(int literal) { return literal >> 1; }
+inline int literalValue(int literal) { return literal & 1; }
+inline int negateLiteral(int literal) { return literal ^ 1; }
+
+class LearnedImplications;
+
+// Direct implications in the fault-free circuit, over 0/1/X: forward
+// evaluation plus the backward rules that are unique (an AND at 1 sets
+// every input to 1; an AND at 0 with all other inputs 1 sets the last one
+// to 0; a XOR with one X input; BUFF, NOT and fanout branches both ways).
+// Values stay assigned until reset(), so several literals can be
+// combined. Scratch state for one thread, sized to the netlist.
+class Implicator {
+public:
+    explicit Implicator(const Netlist& n);
+
+    // Assigns 'literal' and everything it implies, including learned
+    // implications if given. Returns false on a conflict, i.e. the
+    // literals assigned so far cannot all hold.
+    bool assign(int literal, const LearnedImplications* learned = nullptr);
+    // Assigns what every test for a stuck-at fault at 'gate' needs in the
+    // fault-free circuit: the activation value, and a non-controlling
+    // value on each side input (outside the fault's fanout cone) of the
+    // gates that all fault effects must pass through on the way to a PO.
+    // Returns false if that is contradictory, i.e. the fault is untestable.
+    bool assignTestRequirements(int gate, int activationValue, const LearnedImplications* learned);
+
+    // Stops propagating once this many literals are assigned since
+    // reset(). Everything assigned still follows, but a conflict further
+    // on goes unnoticed. Unlimited by default.
+    void setAssignLimit(size_t limit) { assignLimit = limit; }
+
+    // Back to all X
+    void reset();
+    // Everything assigned after getTrailMark() can be undone in one step
+    size_t getTrailMark() const { return assigned.size(); }
+    void undoToMark(size_t mark);
+
+    // -1 for X
+    int getValue(int id) const { return values[id]; }
+    // Every literal assigned since reset(), in assignment order
+    const std::vector<int>& getAssigned() const { return assigned; }
+
+private:
+    bool set(int literal);
+    bool examine(int gate);
+    int intersectDominators(int a, int b) const;
+
+    const Netlist& netlist;
+    std::vector<int8_t> values;
+    std::vector<int> assigned;
+    std::vector<int> pending; // Literals to assign
+    std::vector<int> queue;   // Gates whose rules may now fire
+    const LearnedImplications* learned = nullptr;
+    size_t assignLimit = SIZE_MAX;
+
+    // Fanout cone and immediate post-dominators for assignTestRequirements
+    std::vector<int> cone;
+    std::vector<char> inCone;
+    std::vector<int> dominator; // Next gate every path to a PO goes through
+};
+
+// SOCRATES-style static learning. Every gate is set to 0 and to 1 in
+// turn and the direct implications are collected. If a=v implies b=w
+// where b=w is only reached from b's inputs (an AND at 1, a NOR at 1, a
+// XOR), the contrapositive b=!w => a=!v is not a direct implication of
+// b=!w and is kept, e.g. across reconvergent fanout. A value that
+// conflicts with itself makes the gate constant, stored as a=v => a=!v.
+// Each value is implied only up to IMPLICATION_LIMIT literals, so the
+// pass stays linear in the circuit size. Past 'timeLimitMs' (0 = no
+// limit) it stops and keeps what it has learned so far.
+class LearnedImplications {
+public:
+    static const size_t IMPLICATION_LIMIT = 512;
+
+    static std::unique_ptr<LearnedImplications> learn(const Netlist& netlist, long timeLimitMs = 0);
+
+    // Literals learned to follow from 'literal'
+    IdRange get(int literal) const {
+        return {targets.data() + offsets[literal], targets.data() + offsets[literal + 1]};
+    }
+
+    size_t getCount() const { return targets.size(); }
+    size_t getConstantCount() const { return constants; }
+    double getLearnMs() const { return learnMs; }
+    // False if the time limit cut the pass short; then only the first
+    // getLearnedGateCount() gates were learned from
+    bool isComplete() const { return learnedGates == totalGates; }
+    int getLearnedGateCount() const { return learnedGates; }
+    int getTotalGateCount() const { return totalGates; }
+
+private:
+    LearnedImplications() = default;
+
+    // CSR by source literal
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    size_t constants = 0;
+    double learnMs = 0;
+    int learnedGates = 0;
+    int totalGates = 0;
+};
+
+#endif // STATIC_LEARNING_H
@@ -0,0 +1,353 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <random>
+#include "BenchReader.h"
+#include "Circuit.h"
+#include "Netlist.h"
+#include "NetlistLoader.h"
+#include "SimState.h"
+#include "StaticLearning.h"
+#include "PodemSolver.h"
+
+// Benchmark harness (PODEM_bench): times each phase of a run separately
+// for every circuit in the test directory and writes the results as JSON.
+// compare_bench.py compares two such files and flags regressions.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Repeated timings are reduced to their minimum: on a busy machine noise
+// only ever adds time, so the fastest run is the most reproducible one
+double fastest(const std::vector<double>& samples) {
+    return *std::min_element(samples.begin(), samples.end());
+}
+
+// Nearest-rank percentile of already sorted samples
+double percentile(const std::vector<double>& sorted, double q) {
+    size_t rank = size_t(q * sorted.size() + 0.999999);
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+// PodemSolver::solve over one fault file
+struct SolveStats {
+    std::string faultFile;
+    size_t faults = 0;
+    size_t testsFound = 0;
+    long backtracks = 0;
+    double totalMs = 0;
+    double meanUs = 0, p50Us = 0, p90Us = 0, p99Us = 0, maxUs = 0;
+    long learnedBacktracks = 0; // One more pass with static learning
+    double learnedTotalMs = 0;
+};
+
+struct CircuitStats {
+    std::string name;
+    int gates = 0;
+    int pis = 0;
+    int pos = 0;
+    double parseMs = 0;      // BenchReader, fastest of the repeats
+    double yyparseMs = 0;    // Flex/Bison parser
+    double buildMs = 0;      // Circuit::buildSimulationList
+    double compileMs = 0;    // Netlist construction (CSR, levels, SCOAP)
+    double learnMs = 0;      // LearnedImplications::learn
+    size_t learnedImplications = 0;
+    double gateEvalsPerSec = 0;
+    std::vector<SolveStats> solves;
+};
+
+// --- Phases ---
+
+bool timeParse(const std::string& benchFile, int repeat, CircuitStats& stats) {
+    std::vector<double> parse, yacc, build, compile;
+    for (int r = 0; r < repeat; ++r) {
+        {
+            Circuit circuit;
+            BenchReader reader;
+            auto start = Clock::now();
+            if (!reader.read(benchFile, circuit)) {
+                std::cerr << "Error: " << reader.getError() << std::endl;
+                return false;
+            }
+            parse.push_back(elapsedMs(start));
+
+            start = Clock::now();
+            circuit.buildSimulationList();
+            build.push_back(elapsedMs(start));
+
+            start = Clock::now();
+            Netlist netlist(circuit);
+            compile.push_back(elapsedMs(start));
+        }
+        {
+            Circuit circuit;
+            std::string error;
+            auto start = Clock::now();
+            if (!NetlistLoader::readLegacy(benchFile, circuit, error)) {
+                std::cerr << "Error: " << error << std::endl;
+                return false;
+            }
+            yacc.push_back(elapsedMs(start));
+        }
+    }
+    stats.parseMs = fastest(parse);
+    stats.yyparseMs = fastest(yacc);
+    stats.buildMs = fastest(build);
+    stats.compileMs = fastest(compile);
+    return true;
+}
+
+// Full simulations of random PI vectors, in 'repeat' windows of at least
+// 'minMs' each; returns the best window's rate. Each run includes the
+// reset to X/UNSET that every PODEM call starts with.
+double timeSimulation(const Netlist& netlist, int repeat, double minMs) {
+    SimState state(netlist);
+    std::mt19937 rng(1);
+    const size_t numVectors = 64;
+    std::vector<std::vector<LogicValue>> vectors(numVectors);
+    for (auto& vec : vectors) {
+        for (size_t i = 0; i < netlist.getPIs().size(); ++i) {
+            vec.push_back((rng() & 1) ? LogicValue::ONE : LogicValue::ZERO);
+        }
+    }
+
+    double best = 0;
+    for (int r = 0; r < repeat; ++r) {
+        long runs = 0;
+        double ms = 0;
+        auto start = Clock::now();
+        while (ms < minMs) {
+            for (const auto& vec : vectors) {
+                state.clearAllValues();
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    state.presetPI(netlist.getPIs()[i], vec[i]);
+                }
+                state.runFullSimulation();
+            }
+            runs += numVectors;
+            ms = elapsedMs(start);
+        }
+        best = std::max(best, double(runs) * netlist.getSimulationCount() / (ms / 1000));
+    }
+    return best;
+}
+
+// Solves every fault once per pass and keeps each fault's fastest time.
+// Passes stop after 'repeat', or once they have taken 'budgetMs' in total,
+// so fault lists with hard faults are only solved once.
+bool timeSolve(const Netlist& netlist, const LearnedImplications& learned, const std::string& faultFile,
+               int repeat, double budgetMs, SolveStats& stats) {
+    std::ifstream faultStream(faultFile);
+    if (!faultStream.is_open()) {
+        std::cerr << "Error: Cannot open fault file " << faultFile << std::endl;
+        return false;
+    }
+    stats.faultFile = std::filesystem::path(faultFile).filename().string();
+
+    std::vector<int> sites;
+    std::vector<FaultType> types;
+    std::string faultGateName;
+    int faultVal;
+    while (faultStream >> faultGateName >> faultVal) {
+        int site = netlist.findGate(faultGateName);
+        if (site >= 0) { // ATPG reports the others as errors without running PODEM
+            sites.push_back(site);
+            types.push_back((faultVal == 0) ? FaultType::SA0 : FaultType::SA1);
+        }
+    }
+
+    SimState state(netlist);
+    std::vector<LogicValue> piValues;
+    std::vector<double> latencies(sites.size(), 0); // Microseconds
+    auto begin = Clock::now();
+    for (int pass = 0; pass < repeat && (pass == 0 || elapsedMs(begin) < budgetMs); ++pass) {
+        stats.testsFound = 0;
+        stats.backtracks = 0;
+        for (size_t f = 0; f < sites.size(); ++f) {
+            auto start = Clock::now();
+            state.clearAllValues();
+            PodemSolver solver(netlist, state, sites[f], types[f]);
+            bool found = solver.solve(piValues);
+            double us = elapsedMs(start) * 1000;
+            latencies[f] = (pass == 0) ? us : std::min(latencies[f], us);
+            stats.testsFound += found;
+            stats.backtracks += solver.getBacktrackCount();
+        }
+    }
+
+    // The same faults once more with static learning, for the backtracks
+    // it saves
+    for (size_t f = 0; f < sites.size(); ++f) {
+        auto start = Clock::now();
+        state.clearAllValues();
+        PodemSolver solver(netlist, state, sites[f], types[f]);
+        solver.setLearnedImplications(&learned);
+        solver.solve(piValues);
+        stats.learnedTotalMs += elapsedMs(start);
+        stats.learnedBacktracks += solver.getBacktrackCount();
+    }
+
+    stats.faults = latencies.size();
+    if (latencies.empty()) {
+        return true;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    for (double us : latencies) {
+        stats.totalMs += us / 1000;
+    }
+    stats.meanUs = stats.totalMs * 1000 / latencies.size();
+    stats.p50Us = percentile(latencies, 0.50);
+    stats.p90Us = percentile(latencies, 0.90);
+    stats.p99Us = percentile(latencies, 0.99);
+    stats.maxUs = latencies.back();
+    return true;
+}
+
+// --- Output ---
+
+void writeJson(std::ostream& out, const std::vector<CircuitStats>& circuits, int repeat) {
+    out << std::setprecision(10);
+    out << "{\n  \"version\": 1,\n  \"repeat\": " << repeat << ",\n  \"circuits\": [";
+    for (size_t c = 0; c < circuits.size(); ++c) {
+        const CircuitStats& s = circuits[c];
+        out << (c ? "," : "") << "\n    {\n"
+            << "      \"name\": \"" << s.name << "\",\n"
+            << "      \"gates\": " << s.gates << ",\n"
+            << "      \"pis\": " << s.pis << ",\n"
+            << "      \"pos\": " << s.pos << ",\n"
+            << "      \"parse_ms\": " << s.parseMs << ",\n"
+            << "      \"yyparse_ms\": " << s.yyparseMs << ",\n"
+            << "      \"build_simulation_list_ms\": " << s.buildMs << ",\n"
+            << "      \"netlist_compile_ms\": " << s.compileMs << ",\n"
+            << "      \"gate_evals_per_sec\": " << s.gateEvalsPerSec << ",\n"
+            << "      \"learn_ms\": " << s.learnMs << ",\n"
+            << "      \"learned_implications\": " << s.learnedImplications << ",\n"
+            << "      \"solve\": [";
+        for (size_t f = 0; f < s.solves.size(); ++f) {
+            const SolveStats& v = s.solves[f];
+            out << (f ? "," : "") << "\n        {\"fault_file\": \"" << v.faultFile << "\", \"faults\": " << v.faults
+                << ", \"tests_found\": " << v.testsFound << ", \"backtracks\": " << v.backtracks
+                << ", \"total_ms\": " << v.totalMs << ", \"mean_us\": " << v.meanUs << ", \"p50_us\": " << v.p50Us
+                << ", \"p90_us\": " << v.p90Us << ", \"p99_us\": " << v.p99Us << ", \"max_us\": " << v.maxUs
+                << ", \"learned_backtracks\": " << v.learnedBacktracks << ", \"learned_total_ms\": "
+                << v.learnedTotalMs << "}";
+        }
+        out << (s.solves.empty() ? "]" : "\n      ]") << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // 1. Check Arguments
+    std::string testDir = PODEM_TEST_DIR;
+    std::string jsonFile = "bench.json";
+    int repeat = 5;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonFile = argv[++i];
+        } else if (arg[0] != '-') {
+            testDir = arg;
+        } else {
+            std::cerr << "Usage: ./PODEM_bench [test_dir] [--repeat N] [--json results_file]" << std::endl;
+            return 1;
+        }
+    }
+
+    // 2. Every <name>.bench, with every <name>.*fault next to it
+    std::vector<std::filesystem::path> benchFiles;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(testDir, ec)) {
+        if (entry.path().extension() == ".bench") {
+            benchFiles.push_back(entry.path());
+        }
+    }
+    if (ec || benchFiles.empty()) {
+        std::cerr << "Error: No .bench files in " << testDir << std::endl;
+        return 1;
+    }
+    std::sort(benchFiles.begin(), benchFiles.end());
+
+    // 3. Time each phase
+    std::cout << std::fixed << std::setprecision(3);
+    std::vector<CircuitStats> circuits;
+    for (const auto& benchFile : benchFiles) {
+        CircuitStats stats;
+        stats.name = benchFile.stem().string();
+        if (!timeParse(benchFile.string(), repeat, stats)) {
+            return 1;
+        }
+
+        Circuit circuit;
+        BenchReader reader;
+        reader.read(benchFile.string(), circuit);
+        circuit.buildSimulationList();
+        Netlist netlist(circuit);
+        stats.gates = netlist.getGateCount();
+        stats.pis = int(netlist.getPIs().size());
+        stats.pos = int(netlist.getPOs().size());
+        stats.gateEvalsPerSec = timeSimulation(netlist, repeat, 200);
+
+        std::unique_ptr<LearnedImplications> learned;
+        std::vector<double> learns;
+        for (int r = 0; r < repeat; ++r) {
+            learned = LearnedImplications::learn(netlist);
+            learns.push_back(learned->getLearnMs());
+        }
+        stats.learnMs = fastest(learns);
+        stats.learnedImplications = learned->getCount();
+
+        std::vector<std::filesystem::path> faultFiles;
+        for (const auto& entry : std::filesystem::directory_iterator(benchFile.parent_path())) {
+            std::string file = entry.path().filename().string();
+            if (entry.path().stem() == stats.name && file.size() >= 5 && file.compare(file.size() - 5, 5, "fault") == 0) {
+                faultFiles.push_back(entry.path());
+            }
+        }
+        std::sort(faultFiles.begin(), faultFiles.end());
+        for (const auto& faultFile : faultFiles) {
+            SolveStats solve;
+            if (!timeSolve(netlist, *learned, faultFile.string(), repeat, 2000, solve)) {
+                return 1;
+            }
+            stats.solves.push_back(solve);
+        }
+
+        std::cout << stats.name << ": parse " << stats.parseMs << " ms (yyparse " << stats.yyparseMs
+                  << " ms), buildSimulationList " << stats.buildMs << " ms, netlist " << stats.compileMs
+                  << " ms, " << stats.gateEvalsPerSec / 1e6 << " M gate evals/s, static learning " << stats.learnMs
+                  << " ms (" << stats.learnedImplications << " implications)" << std::endl;
+        for (const SolveStats& solve : stats.solves) {
+            std::cout << "  " << solve.faultFile << ": " << solve.faults << " faults, solve p50 " << solve.p50Us
+                      << " us, p90 " << solve.p90Us << " us, p99 " << solve.p99Us << " us, max " << solve.maxUs
+                      << " us, " << solve.backtracks << " backtracks (" << solve.learnedBacktracks
+                      << " with learning)" << std::endl;
+        }
+        circuits.push_back(stats);
+    }
+
+    // 4. Write the results
+    std::ofstream jsonStream(jsonFile);
+    if (!jsonStream.is_open()) {
+        std::cerr << "Error: Cannot open output file " << jsonFile << std::endl;
+        return 1;
+    }
+    writeJson(jsonStream, circuits, repeat);
+    std::cout << "Benchmark complete. Results in " << jsonFile << std::endl;
+    return 0;
+}
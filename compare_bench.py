@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Compare two PODEM_bench JSON files and flag regressions.
+
+Usage: compare_bench.py baseline.json current.json [--threshold PCT] [--min-ms MS]
+
+A metric regresses when it is worse than the baseline by more than
+--threshold percent (default 10). Times (*_ms, *_us) and backtracks are
+better when lower, gate_evals_per_sec when higher. Metrics missing from
+either file (added in a later version) are skipped. Times where both runs
+are under --min-ms (default 0.05 ms) are too small to measure reliably
+and are skipped. Exits with status 1 if anything regressed.
+"""
+
+import argparse
+import json
+import sys
+
+CIRCUIT_METRICS = ["parse_ms", "yyparse_ms", "build_simulation_list_ms", "netlist_compile_ms",
+                   "gate_evals_per_sec", "learn_ms"]
+SOLVE_METRICS = ["backtracks", "total_ms", "mean_us", "p50_us", "p90_us", "p99_us", "max_us",
+                 "learned_backtracks", "learned_total_ms"]
+
+
+def in_ms(metric, value):
+    if metric.endswith("_us"):
+        return value / 1000.0
+    if metric.endswith("_ms"):
+        return value
+    return None
+
+
+def compare(label, metric, old, new, args, rows):
+    """Appends one row; returns True if it is a regression."""
+    if old is None or new is None:
+        return False  # Metric added after one of the runs
+    old_ms, new_ms = in_ms(metric, old), in_ms(metric, new)
+    if old_ms is not None and max(old_ms, new_ms) < args.min_ms:
+        return False
+    if old == 0:
+        change = 0.0 if new == 0 else float("inf")
+    else:
+        change = (new - old) / old * 100.0
+    worse = -change if metric == "gate_evals_per_sec" else change
+    regressed = worse > args.threshold
+    rows.append((label, metric, old, new, change, "REGRESSION" if regressed else ""))
+    return regressed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flag regressions between two PODEM_bench runs.")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown in percent")
+    parser.add_argument("--min-ms", type=float, default=0.05, help="ignore times below this")
+    args = parser.parse_args()
+
+    with open(args.baseline) as f:
+        baseline = {c["name"]: c for c in json.load(f)["circuits"]}
+    with open(args.current) as f:
+        current = {c["name"]: c for c in json.load(f)["circuits"]}
+
+    rows = []
+    regressions = 0
+    for name in sorted(baseline.keys() & current.keys()):
+        old, new = baseline[name], current[name]
+        for metric in CIRCUIT_METRICS:
+            regressions += compare(name, metric, old.get(metric), new.get(metric), args, rows)
+        old_solves = {s["fault_file"]: s for s in old["solve"]}
+        for solve in new["solve"]:
+            base = old_solves.get(solve["fault_file"])
+            if base is None:
+                continue
+            for metric in SOLVE_METRICS:
+                regressions += compare(solve["fault_file"], metric, base.get(metric), solve.get(metric), args,
+                                       rows)
+
+    for label, metric, old, new, change, flag in rows:
+        print(f"{label:16} {metric:26} {old:14.6g} {new:14.6g} {change:+8.1f}%  {flag}")
+    for name in sorted(baseline.keys() ^ current.keys()):
+        print(f"{name}: only in {'baseline' if name in baseline else 'current'} run")
+
+    print(f"{regressions} regression(s) over {args.threshold:g}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
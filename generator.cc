@@ -0,0 +1,355 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// Synthetic netlist generator (PODEM_gen): writes a random, valid .bench
+// file and a matching fault list, for scaling tests of the parser,
+// levelizer, simulator and solver on circuits far larger than test/.
+//
+// Signals are numbered PIs first, then gates level by level. Every gate's
+// first input comes from the level right below it, so the circuit has
+// exactly the requested depth; its other inputs come from any lower level.
+// Gates that drive nothing become POs, so no logic is dead.
+
+namespace {
+
+struct GeneratorOptions {
+    long gates = 10000;
+    long inputs = 0;        // 0 = gates / 50, at least 8
+    long outputs = 0;       // Extra POs beyond the gates that drive nothing
+    long depth = 0;         // 0 = about sqrt(gates)
+    int maxFanin = 4;       // Multi-input gates get 2..maxFanin inputs
+    double fanoutSkew = 0;  // Share of inputs picked by preferential attachment
+    double reconvergence = 0.2;
+    long faults = 1000;     // -1 = both faults on every net
+    uint64_t seed = 1;
+    // Weights of AND, NAND, OR, NOR, XOR, XNOR, NOT, BUFF
+    std::vector<double> mix = {25, 25, 15, 15, 5, 5, 8, 2};
+};
+
+const char* const TYPE_NAMES[] = {"AND", "NAND", "OR", "NOR", "XOR", "XNOR", "NOT", "BUFF"};
+const int NUM_TYPES = 8;
+const int FIRST_SINGLE_INPUT = 6; // NOT and BUFF
+
+// Buffered writer for multi-gigabyte outputs
+class FileWriter {
+public:
+    explicit FileWriter(const std::string& path) : file(std::fopen(path.c_str(), "w")) {
+        buffer.reserve(BUFFER_BYTES);
+    }
+    ~FileWriter() { close(); }
+
+    bool isOpen() const { return file != nullptr; }
+    void put(const char* text) { buffer.append(text); }
+    void put(char c) { buffer.push_back(c); }
+    void putNumber(uint64_t n) {
+        char digits[24];
+        buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), n).ptr);
+    }
+    void endLine() {
+        buffer.push_back('\n');
+        if (buffer.size() >= BUFFER_BYTES) {
+            flush();
+        }
+    }
+    bool close() {
+        if (!file) {
+            return true;
+        }
+        flush();
+        bool ok = !std::ferror(file);
+        ok = (std::fclose(file) == 0) && ok;
+        file = nullptr;
+        return ok;
+    }
+
+private:
+    static const size_t BUFFER_BYTES = 1 << 20;
+    void flush() {
+        std::fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+    std::FILE* file;
+    std::string buffer;
+};
+
+class Generator {
+public:
+    Generator(const GeneratorOptions& opts) : options(opts), rng(opts.seed) {}
+
+    bool writeBench(const std::string& path);
+    bool writeFaults(const std::string& path);
+
+private:
+    void putName(FileWriter& out, long signal) const {
+        if (signal < options.inputs) {
+            out.put('i');
+            out.putNumber(signal);
+        } else {
+            out.put('g');
+            out.putNumber(signal - options.inputs);
+        }
+    }
+    long uniform(long lo, long hi) { // [lo, hi)
+        return lo + long(rng() % uint64_t(hi - lo));
+    }
+    double chance() { return std::uniform_real_distribution<double>(0, 1)(rng); }
+    long pickInput(long levelStart, long first);
+
+    GeneratorOptions options;
+    std::mt19937_64 rng;
+    std::vector<int32_t> firstInput; // Per signal, -1 for PIs
+    std::vector<char> role;          // 0 = unused so far, 1 = drives a gate, 2 = PO
+    std::vector<int32_t> endpoints;  // Every signal once, plus once per fanout
+    size_t endpointsBelow = 0;       // Entries from signals below the current level
+};
+
+// A non-first input. Reconvergent picks walk 1-3 steps down the first
+// input's chain of first inputs, so the chosen signal reaches this gate
+// along two paths.
+long Generator::pickInput(long levelStart, long first) {
+    if (first >= options.inputs && chance() < options.reconvergence) {
+        long signal = first;
+        for (int steps = int(uniform(1, 4)); steps > 0 && firstInput[signal] >= 0; --steps) {
+            signal = firstInput[signal];
+        }
+        if (signal != first) {
+            return signal;
+        }
+    }
+    if (options.fanoutSkew > 0 && chance() < options.fanoutSkew) {
+        return endpoints[uniform(0, long(endpointsBelow))];
+    }
+    return uniform(0, levelStart);
+}
+
+bool Generator::writeBench(const std::string& path) {
+    FileWriter out(path);
+    if (!out.isOpen()) {
+        return false;
+    }
+    long signals = options.inputs + options.gates;
+    firstInput.assign(signals, -1);
+    role.assign(signals, 0);
+    if (options.fanoutSkew > 0) {
+        endpoints.reserve(signals * 3);
+    }
+
+    out.put("# PODEM_gen: ");
+    out.putNumber(options.inputs);
+    out.put(" inputs, ");
+    out.putNumber(options.gates);
+    out.put(" gates, depth ");
+    out.putNumber(options.depth);
+    out.put(", seed ");
+    out.putNumber(options.seed);
+    out.endLine();
+    for (long i = 0; i < options.inputs; ++i) {
+        out.put("INPUT(");
+        putName(out, i);
+        out.put(')');
+        out.endLine();
+        if (options.fanoutSkew > 0) {
+            endpoints.push_back(int32_t(i));
+        }
+    }
+
+    std::discrete_distribution<int> typeDist(options.mix.begin(), options.mix.end());
+    long prevStart = 0;
+    long levelStart = options.inputs;
+    long signal = options.inputs;
+    std::vector<long> inputs;
+    for (long level = 0; level < options.depth; ++level) {
+        long levelSize = options.gates / options.depth + (level < options.gates % options.depth ? 1 : 0);
+        endpointsBelow = endpoints.size();
+        for (long k = 0; k < levelSize; ++k, ++signal) {
+            int type = typeDist(rng);
+            int fanin = (type >= FIRST_SINGLE_INPUT) ? 1 : int(uniform(2, options.maxFanin + 1));
+
+            // First input from the level below; the first level spreads over
+            // the PIs in turn so that each one is used
+            inputs.clear();
+            inputs.push_back(level == 0 ? k % options.inputs : uniform(prevStart, levelStart));
+            for (int attempt = 0; int(inputs.size()) < fanin && attempt < 4 * fanin; ++attempt) {
+                long in = pickInput(levelStart, inputs[0]);
+                if (std::find(inputs.begin(), inputs.end(), in) == inputs.end()) {
+                    inputs.push_back(in);
+                }
+            }
+            if (inputs.size() == 1 && type < FIRST_SINGLE_INPUT) {
+                type = (type % 2 == 0) ? NUM_TYPES - 1 : FIRST_SINGLE_INPUT; // BUFF or NOT
+            }
+
+            firstInput[signal] = int32_t(inputs[0]);
+            putName(out, signal);
+            out.put(" = ");
+            out.put(TYPE_NAMES[type]);
+            out.put('(');
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                if (i) {
+                    out.put(", ");
+                }
+                putName(out, inputs[i]);
+                role[inputs[i]] = 1;
+                if (options.fanoutSkew > 0) {
+                    endpoints.push_back(int32_t(inputs[i]));
+                }
+            }
+            out.put(')');
+            out.endLine();
+            if (options.fanoutSkew > 0) {
+                endpoints.push_back(int32_t(signal));
+            }
+        }
+        prevStart = levelStart;
+        levelStart = signal;
+    }
+
+    // POs: every gate that drives nothing, then random extra ones
+    for (long s = options.inputs; s < signals; ++s) {
+        if (role[s] == 0) {
+            role[s] = 2;
+            out.put("OUTPUT(");
+            putName(out, s);
+            out.put(')');
+            out.endLine();
+        }
+    }
+    long added = 0;
+    for (long attempt = 0; added < options.outputs && attempt < 4 * options.outputs; ++attempt) {
+        long s = uniform(options.inputs, signals);
+        if (role[s] != 2) {
+            role[s] = 2;
+            added++;
+            out.put("OUTPUT(");
+            putName(out, s);
+            out.put(')');
+            out.endLine();
+        }
+    }
+    return out.close();
+}
+
+// Random stuck-at faults on stems (PIs and gate outputs)
+bool Generator::writeFaults(const std::string& path) {
+    FileWriter out(path);
+    if (!out.isOpen()) {
+        return false;
+    }
+    long signals = options.inputs + options.gates;
+    long count = (options.faults < 0) ? 2 * signals : options.faults;
+    for (long f = 0; f < count; ++f) {
+        long s = (options.faults < 0) ? f / 2 : uniform(0, signals);
+        putName(out, s);
+        out.put(' ');
+        out.putNumber((options.faults < 0) ? f % 2 : rng() & 1);
+        out.endLine();
+    }
+    return out.close();
+}
+
+bool parseMix(const std::string& spec, std::vector<double>& mix) {
+    std::vector<double> weights(NUM_TYPES, 0);
+    size_t pos = 0;
+    while (pos < spec.size()) {
+        size_t comma = spec.find(',', pos);
+        std::string item = spec.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) {
+            return false;
+        }
+        std::string name = item.substr(0, eq);
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        auto it = std::find(TYPE_NAMES, TYPE_NAMES + NUM_TYPES, name);
+        if (it == TYPE_NAMES + NUM_TYPES) {
+            return false;
+        }
+        weights[it - TYPE_NAMES] = std::max(0.0, std::atof(item.c_str() + eq + 1));
+        pos = (comma == std::string::npos) ? spec.size() : comma + 1;
+    }
+    if (std::all_of(weights.begin(), weights.end(), [](double w) { return w == 0; })) {
+        return false;
+    }
+    mix = weights;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // 1. Check Arguments
+    GeneratorOptions options;
+    std::vector<std::string> fileArgs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--gates" && hasValue) {
+            options.gates = std::max(1L, std::atol(argv[++i]));
+        } else if (arg == "--inputs" && hasValue) {
+            options.inputs = std::max(1L, std::atol(argv[++i]));
+        } else if (arg == "--outputs" && hasValue) {
+            options.outputs = std::max(0L, std::atol(argv[++i]));
+        } else if (arg == "--depth" && hasValue) {
+            options.depth = std::max(1L, std::atol(argv[++i]));
+        } else if (arg == "--max-fanin" && hasValue) {
+            options.maxFanin = std::max(2, std::atoi(argv[++i]));
+        } else if (arg == "--fanout-skew" && hasValue) {
+            options.fanoutSkew = std::clamp(std::atof(argv[++i]), 0.0, 1.0);
+        } else if (arg == "--reconvergence" && hasValue) {
+            options.reconvergence = std::clamp(std::atof(argv[++i]), 0.0, 1.0);
+        } else if (arg == "--faults" && hasValue) {
+            std::string count = argv[++i];
+            options.faults = (count == "all") ? -1 : std::max(0L, std::atol(count.c_str()));
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--mix" && hasValue) {
+            if (!parseMix(argv[++i], options.mix)) {
+                std::cerr << "Error: Bad --mix " << argv[i] << " (expected e.g. and=2,nand=1,xor=1)" << std::endl;
+                return 1;
+            }
+        } else if (arg[0] != '-') {
+            fileArgs.push_back(arg);
+        } else {
+            fileArgs.clear();
+            break;
+        }
+    }
+    if (fileArgs.empty() || fileArgs.size() > 2) {
+        std::cerr << "Usage: ./PODEM_gen [bench_file] [fault_file] [--gates N] [--inputs N] [--outputs N]" << std::endl;
+        std::cerr << "                [--depth D] [--max-fanin K] [--mix and=W,nand=W,...] [--fanout-skew P]" << std::endl;
+        std::cerr << "                [--reconvergence P] [--faults N|all] [--seed S]" << std::endl;
+        return 1;
+    }
+    if (options.gates > INT32_MAX / 2) {
+        std::cerr << "Error: --gates must be below " << INT32_MAX / 2 << std::endl;
+        return 1;
+    }
+    if (options.inputs == 0) {
+        options.inputs = std::max(8L, options.gates / 50);
+    }
+    if (options.depth == 0) {
+        options.depth = std::max(1L, long(std::sqrt(double(options.gates))));
+    }
+    options.depth = std::min(options.depth, options.gates);
+
+    // 2. Write the circuit, then the faults
+    Generator generator(options);
+    if (!generator.writeBench(fileArgs[0])) {
+        std::cerr << "Error: Cannot write bench file " << fileArgs[0] << std::endl;
+        return 1;
+    }
+    if (fileArgs.size() == 2 && !generator.writeFaults(fileArgs[1])) {
+        std::cerr << "Error: Cannot write fault file " << fileArgs[1] << std::endl;
+        return 1;
+    }
+    std::cout << "Generated " << options.gates << " gates (" << options.inputs << " inputs, depth "
+              << options.depth << ") in " << fileArgs[0] << std::endl;
+    return 0;
+}
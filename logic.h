@@ -1,17 +1,29 @@
 #ifndef LOGIC_H
 #define LOGIC_H
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 
-// Use enum class for type-safe enumerations
-enum class LogicValue {
-    ZERO,
-    ONE,
-    D,
-    DBAR,
-    X,
-    UNSET
+// Use enum class for type-safe enumerations.
+// One byte per value, so state arrays can be copied/cleared in bulk.
+//
+// Values are dual-rail encoded: each of the good and the faulty machine
+// gets an "is 0" and an "is 1" rail, so the 5-valued operators in
+// logic_util reduce to a few bitwise operations.
+//
+//   bit 0: good machine is 0     bit 2: faulty machine is 0
+//   bit 1: good machine is 1     bit 3: faulty machine is 1
+//
+// X has no rail set. UNSET (never simulated) has no rail set either, so
+// AND/OR/XOR treat it like X; only a separate tag bit tells it apart.
+enum class LogicValue : uint8_t {
+    ZERO  = 0x5, // good 0, faulty 0
+    ONE   = 0xA, // good 1, faulty 1
+    D     = 0x6, // good 1, faulty 0
+    DBAR  = 0x9, // good 0, faulty 1
+    X     = 0x0,
+    UNSET = 0x10
 };
 
 enum class FaultType {
@@ -20,8 +32,9 @@ enum class FaultType {
     SA1
 };
 
-// Add PI (Primary Input) and PO (Primary Output) types
-enum class GateType {
+// Add PI (Primary Input) and PO (Primary Output) types.
+// Also used as the one-byte opcode of the compiled Netlist.
+enum class GateType : uint8_t {
     PI,
     PO,
     AND,
@@ -4,21 +4,70 @@
 #include "logic.h"
 #include <vector>
 
+// The operators work directly on the dual-rail encoding from logic.h.
+// They are inline because the simulators call them once per gate input.
+namespace logic_detail {
+    const uint8_t RAIL_0 = 0x5; // "is 0" rails of both machines
+    const uint8_t RAIL_1 = 0xA; // "is 1" rails of both machines
+    const uint8_t UNSET_TAG = 0x10;
+
+    inline uint8_t bits(LogicValue v) { return static_cast<uint8_t>(v); }
+
+    // Exchanges the 0 and 1 rails of both machines
+    inline uint8_t swap_rails(uint8_t v) {
+        return ((v & RAIL_0) << 1) | ((v >> 1) & RAIL_0);
+    }
+
+    // The 5-valued algebra has no half-known values: unless both machines
+    // end up with exactly one rail set, the result is X.
+    // Binary operators only keep rail bits, so UNSET inputs act as X.
+    inline LogicValue collapse(uint8_t v) {
+        bool valid = ((v ^ (v >> 1)) & RAIL_0) == RAIL_0;
+        return static_cast<LogicValue>(valid ? v : 0);
+    }
+}
+
 // 5-valued logic NOT
-LogicValue logic_not(LogicValue val);
+inline LogicValue logic_not(LogicValue val) {
+    using namespace logic_detail;
+    // X has no rails to swap; UNSET keeps its tag
+    uint8_t v = bits(val);
+    return static_cast<LogicValue>(swap_rails(v) | (v & UNSET_TAG));
+}
 
-// 5-valued logic AND
-LogicValue logic_and(LogicValue v1, LogicValue v2);
+// 5-valued logic AND: a machine is 1 if both inputs are 1,
+// and 0 if either input is 0
+inline LogicValue logic_and(LogicValue v1, LogicValue v2) {
+    using namespace logic_detail;
+    uint8_t a = bits(v1), b = bits(v2);
+    return collapse(((a & b) & RAIL_1) | ((a | b) & RAIL_0));
+}
 
 // 5-valued logic OR
-LogicValue logic_or(LogicValue v1, LogicValue v2);
+inline LogicValue logic_or(LogicValue v1, LogicValue v2) {
+    using namespace logic_detail;
+    uint8_t a = bits(v1), b = bits(v2);
+    return collapse(((a | b) & RAIL_1) | ((a & b) & RAIL_0));
+}
 
-// 5-valued logic XOR
-LogicValue logic_xor(LogicValue v1, LogicValue v2);
+// 5-valued logic XOR: a machine is 1 if one input is 1 and the other 0,
+// and 0 if both inputs are known and equal
+inline LogicValue logic_xor(LogicValue v1, LogicValue v2) {
+    using namespace logic_detail;
+    uint8_t a = bits(v1), b = bits(v2);
+    uint8_t differ = a & swap_rails(b); // (a1 & b0) at rail 1, (a0 & b1) at rail 0
+    uint8_t same = a & b;               // (a1 & b1) at rail 1, (a0 & b0) at rail 0
+    uint8_t one = (differ | (differ << 1)) & RAIL_1;
+    uint8_t zero = (same | (same >> 1)) & RAIL_0;
+    return collapse(one | zero);
+}
 
 // These can be derived from the ones above
-LogicValue logic_nand(LogicValue v1, LogicValue v2);
-LogicValue logic_nor(LogicValue v1, LogicValue v2);
-LogicValue logic_xnor(LogicValue v1, LogicValue v2);
+inline LogicValue logic_nand(LogicValue v1, LogicValue v2) { return logic_not(logic_and(v1, v2)); }
+inline LogicValue logic_nor(LogicValue v1, LogicValue v2) { return logic_not(logic_or(v1, v2)); }
+inline LogicValue logic_xnor(LogicValue v1, LogicValue v2) { return logic_not(logic_xor(v1, v2)); }
+
+// Applies a stuck-at fault to a gate's fault-free output value
+LogicValue applyFault(LogicValue goodValue, FaultType fault);
 
-#endif // LOGIC_UTIL_H
\ No newline at end of file
+#endif // LOGIC_UTIL_H
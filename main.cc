@@ -2,60 +2,496 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <sys/resource.h>
 #include "Circuit.h"
-#include "PodemSolver.h"
+#include "Netlist.h"
+#include "NetlistLoader.h"
+#include "AtpgRunner.h"
+#include "AtpgServer.h"
+#include "FaultSimulator.h"
+#include "FaultCollapser.h"
+#include "PatternCompactor.h"
+#include "PatternFile.h"
+#include "ResultWriter.h"
+#include "SearchStats.h"
 
-// Bison/Flex C-style functions
-extern "C" {
-    extern FILE *yyin;
-    extern int yyparse();
+// Helper to read a test vector character back into a logic value
+LogicValue parsePIValue(char c) {
+    switch(c) {
+        case '0': return LogicValue::ZERO;
+        case '1': return LogicValue::ONE;
+        default:  return LogicValue::X;
+    }
+}
+
+// Builds the compiled netlist for 'benchFile', see NetlistLoader. The
+// Flex/Bison parser is kept behind --legacy-parser.
+std::unique_ptr<Netlist> loadNetlist(const std::string& benchFile, bool legacyParser = false,
+                                     const std::string& cacheFile = std::string()) {
+    NetlistLoader loader(std::cout, std::cerr);
+    loader.setLegacyParser(legacyParser);
+    loader.setCacheFile(cacheFile);
+    std::unique_ptr<Netlist> netlist = loader.load(benchFile);
+    if (!netlist) {
+        std::cerr << "Error: " << loader.getError() << std::endl;
+    }
+    return netlist;
+}
+
+// Peak resident set size of the whole run, per gate of the (fanout-
+// expanded) netlist, to keep an eye on the memory footprint
+void reportPeakMemory(const Netlist& netlist) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    size_t bytes = usage.ru_maxrss;        // Bytes on macOS
+#else
+    size_t bytes = usage.ru_maxrss * 1024; // Kilobytes on Linux
+#endif
+    size_t gates = std::max(1, netlist.getGateCount());
+    std::cout << "Peak RSS: " << bytes / (1024 * 1024) << " MB (" << bytes / gates << " bytes per gate, "
+              << netlist.getGateCount() << " gates)" << std::endl;
+}
+
+// Grading mode: fault-simulates an existing pattern set against a fault list
+int runGrading(const std::string& benchFile, const std::string& reportFile,
+               const std::string& faultFile, const std::string& patternFile) {
+    std::unique_ptr<Netlist> netlistPtr = loadNetlist(benchFile);
+    if (!netlistPtr) {
+        return 1;
+    }
+    const Netlist& netlist = *netlistPtr;
+
+    std::ifstream faultStream(faultFile);
+    std::ifstream patternStream(patternFile);
+    std::ofstream reportStream(reportFile);
+
+    if (!faultStream.is_open()) {
+        std::cerr << "Error: Cannot open fault file " << faultFile << std::endl;
+        return 1;
+    }
+    if (!patternStream.is_open()) {
+        std::cerr << "Error: Cannot open pattern file " << patternFile << std::endl;
+        return 1;
+    }
+    if (!reportStream.is_open()) {
+        std::cerr << "Error: Cannot open output file " << reportFile << std::endl;
+        return 1;
+    }
+    PatternReader binaryPatterns;
+    bool isBinary = PatternReader::isPatternFile(patternFile);
+    if (isBinary && !binaryPatterns.open(patternFile, netlist)) {
+        std::cerr << "Error: " << binaryPatterns.getError() << std::endl;
+        return 1;
+    }
+
+    // 1. Read the whole fault list; gates that don't exist are reported as errors
+    std::vector<int> faultSites;
+    std::vector<FaultType> faultTypes;
+    std::string faultGateName;
+    int faultVal;
+    while (faultStream >> faultGateName >> faultVal) {
+        int site = netlist.findGate(faultGateName);
+        if (site < 0) {
+            std::cerr << "Error processing fault " << faultGateName << ": Fault gate not found" << std::endl;
+        }
+        faultSites.push_back(site);
+        faultTypes.push_back((faultVal == 0) ? FaultType::SA0 : FaultType::SA1);
+    }
+
+    // 2. Stream the patterns through the simulator, one block at a time.
+    // Detected faults are dropped so later blocks only see the hard ones.
+    FaultSimulator simulator(netlist, FaultSimulator::MAX_BLOCK_WORDS);
+    std::vector<long> detectedBy(faultSites.size(), 0); // Pattern line, 0 = undetected
+    std::vector<long> blockLines;
+    std::vector<LogicValue> piValues(netlist.getPIs().size());
+    size_t numPIs = netlist.getPIs().size();
+    long lineNumber = 0;
+    long patternsRead = 0;
+
+    auto gradeBlock = [&]() {
+        if (simulator.getPatternCount() == 0) {
+            return;
+        }
+        simulator.simulateGood();
+        for (size_t i = 0; i < faultSites.size(); ++i) {
+            if (detectedBy[i] != 0 || faultSites[i] < 0) {
+                continue;
+            }
+            int first = simulator.simulateFault(faultSites[i], faultTypes[i]);
+            if (first >= 0) {
+                detectedBy[i] = blockLines[first];
+            }
+        }
+        simulator.clearPatterns();
+        blockLines.clear();
+    };
+
+    simulator.clearPatterns();
+    std::string line;
+    // Binary pattern files have no other lines, so patterns are numbered from 1
+    for (size_t p = 0; isBinary && p < binaryPatterns.getPatternCount(); ++p) {
+        binaryPatterns.getPattern(p, piValues);
+        simulator.addPattern(piValues);
+        blockLines.push_back(p + 1);
+        patternsRead++;
+        if (simulator.isFull()) {
+            gradeBlock();
+        }
+    }
+    while (!isBinary && std::getline(patternStream, line)) {
+        lineNumber++;
+        // Skip anything that isn't a vector, e.g. "none found" lines
+        if (line.size() != numPIs || line.find_first_not_of("01X") != std::string::npos) {
+            continue;
+        }
+        for (size_t i = 0; i < numPIs; ++i) {
+            piValues[i] = parsePIValue(line[i]);
+        }
+        simulator.addPattern(piValues);
+        blockLines.push_back(lineNumber);
+        patternsRead++;
+        if (simulator.isFull()) {
+            gradeBlock();
+        }
+    }
+    gradeBlock();
+
+    // 3. Report one line per fault, in fault-file order
+    size_t numDetected = 0;
+    for (size_t i = 0; i < faultSites.size(); ++i) {
+        if (faultSites[i] < 0) {
+            reportStream << "error" << std::endl;
+        } else if (detectedBy[i] != 0) {
+            reportStream << "detected " << detectedBy[i] << std::endl;
+            numDetected++;
+        } else {
+            reportStream << "undetected" << std::endl;
+        }
+    }
+
+    double coverage = faultSites.empty() ? 0.0 : 100.0 * numDetected / faultSites.size();
+    std::cout << "Patterns graded: " << patternsRead << std::endl;
+    std::cout << "Fault coverage: " << numDetected << "/" << faultSites.size()
+              << " (" << coverage << "%)" << std::endl;
+    std::cout << "Grading complete. Results in " << reportFile << std::endl;
+    return 0;
 }
 
-// The global bridge for the parser
-Circuit* g_Circuit = nullptr;
 
-// Helper to print test vectors
-std::string printPIValue(LogicValue v) {
-    switch(v) {
-        case LogicValue::ZERO: return "0";
-        case LogicValue::ONE:  return "1";
-        case LogicValue::D:    return "1"; // D means 1 in good, 0 in bad
-        case LogicValue::DBAR: return "0"; // DBAR means 0 in good, 1 in bad
-        default:               return "X";
+// Runs PODEM on 'specs' and returns the output line of each one
+static std::vector<std::string> runAndCollect(AtpgRunner& runner, const std::vector<FaultSpec>& specs,
+                                              size_t& abortedCount) {
+    std::stringstream buffer;
+    ResultWriter writer(buffer);
+    runner.run(specs, writer);
+    abortedCount += runner.getAbortedCount();
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(buffer, line)) {
+        lines.push_back(line);
     }
+    return lines;
 }
 
+// Collapsed ATPG: PODEM runs once per equivalence class, and a class that
+// dominates another targeted class reuses that class's vector once fault
+// simulation confirms it. Every original fault line gets its class's result.
+static void runCollapsedAtpg(const Netlist& netlist, AtpgRunner& runner, const std::vector<FaultSpec>& faults,
+                             ResultWriter& out, size_t& abortedCount) {
+    FaultCollapser collapser(netlist);
+    size_t numFaults = 2 * netlist.getGateCount();
+
+    // 1. Map every line to its class. Unknown gates are passed through
+    // unchanged, so the runner reports them as before.
+    std::vector<int> classOf(faults.size(), -1);
+    std::vector<char> targeted(numFaults, 0);
+    for (size_t f = 0; f < faults.size(); ++f) {
+        int site = netlist.findGate(faults[f].gateName);
+        if (site >= 0) {
+            classOf[f] = collapser.getClass(site, faults[f].value == 0 ? 0 : 1);
+            targeted[classOf[f]] = 1;
+        }
+    }
+    std::vector<std::vector<int>> covering;
+    std::vector<char> dominating = collapser.selectDominating(targeted, covering);
+
+    // 2. PODEM on one representative per remaining class, in file order
+    std::vector<FaultSpec> specs;
+    std::vector<int> specClass;
+    std::vector<char> queued(numFaults, 0);
+    std::vector<int> dominatingClasses;
+    for (size_t f = 0; f < faults.size(); ++f) {
+        int c = classOf[f];
+        if (c >= 0 && queued[c]) {
+            continue;
+        }
+        if (c >= 0) {
+            queued[c] = 1;
+            if (dominating[c]) {
+                dominatingClasses.push_back(c);
+                continue;
+            }
+            specs.push_back({std::string(netlist.getName(c / 2)), c % 2});
+        } else {
+            specs.push_back(faults[f]);
+        }
+        specClass.push_back(c);
+    }
+    std::vector<std::string> lines = runAndCollect(runner, specs, abortedCount);
+
+    std::vector<std::string> classLine(numFaults);
+    std::vector<std::string> unknownLine(faults.size());
+    for (size_t i = 0, f = 0; i < specs.size(); ++i) {
+        if (specClass[i] >= 0) {
+            classLine[specClass[i]] = lines[i];
+            continue;
+        }
+        while (classOf[f] >= 0) {
+            f++; // Lines for unknown gates come back in file order
+        }
+        unknownLine[f++] = lines[i];
+    }
+
+    // 3. Dominating classes: try the vectors of the classes they dominate
+    FaultSimulator simulator(netlist);
+    std::vector<LogicValue> piValues(netlist.getPIs().size());
+    std::vector<FaultSpec> fallback;
+    std::vector<int> fallbackClass;
+    size_t verified = 0;
+    for (int c : dominatingClasses) {
+        FaultType type = (c % 2 == 0) ? FaultType::SA0 : FaultType::SA1;
+        for (int dominated : covering[c]) {
+            const std::string& vec = classLine[dominated];
+            if (vec.size() != piValues.size() || vec.find_first_not_of("01X") != std::string::npos) {
+                continue; // No vector: "none found", "aborted", ...
+            }
+            for (size_t i = 0; i < piValues.size(); ++i) {
+                piValues[i] = parsePIValue(vec[i]);
+            }
+            simulator.clearPatterns();
+            simulator.addPattern(piValues);
+            simulator.simulateGood();
+            if (simulator.simulateFault(c / 2, type) >= 0) {
+                classLine[c] = vec;
+                break;
+            }
+        }
+        if (classLine[c].empty()) {
+            // Dominance only transfers tests; if none of the dominated
+            // classes had one, this class still needs its own search
+            fallback.push_back({std::string(netlist.getName(c / 2)), c % 2});
+            fallbackClass.push_back(c);
+        } else {
+            verified++;
+        }
+    }
+    lines = runAndCollect(runner, fallback, abortedCount);
+    for (size_t i = 0; i < fallback.size(); ++i) {
+        classLine[fallbackClass[i]] = lines[i];
+    }
+
+    // 4. One line per original fault, in file order
+    for (size_t f = 0; f < faults.size(); ++f) {
+        out.writeLine(classOf[f] >= 0 ? classLine[classOf[f]] : unknownLine[f]);
+    }
+
+    std::cout << "Fault collapsing: " << faults.size() << " faults -> " << specs.size() + dominatingClasses.size()
+              << " classes; " << verified << " dominating classes covered by fault simulation, PODEM ran on "
+              << specs.size() + fallback.size() << std::endl;
+}
+
+// Static compaction post-pass: writes the compacted patterns to
+// 'patternFile' (and 'binaryPatterns', if given) and, next to it, a map
+// from each fault to its pattern
+static bool writeCompactedPatterns(const Netlist& netlist, const std::vector<FaultSpec>& faults,
+                                   const std::vector<std::string>& lines, const std::string& patternFile,
+                                   PatternWriter* binaryPatterns) {
+    std::string mapFile = patternFile + ".map";
+    std::ofstream patternStream(patternFile);
+    std::ofstream mapStream(mapFile);
+    if (!patternStream.is_open() || !mapStream.is_open()) {
+        std::cerr << "Error: Cannot open compaction output " << patternFile << std::endl;
+        return false;
+    }
+
+    PatternCompactor compactor(netlist);
+    compactor.compact(faults, lines);
+    for (const std::string& pattern : compactor.getPatterns()) {
+        patternStream << pattern << "\n";
+        if (binaryPatterns) {
+            binaryPatterns->add(pattern);
+        }
+    }
+
+    // One line per fault: gate, stuck-at value and the 1-based pattern line
+    const std::vector<int>& faultPatterns = compactor.getFaultPatterns();
+    for (size_t f = 0; f < faults.size(); ++f) {
+        mapStream << faults[f].gateName << " " << faults[f].value << " ";
+        if (faultPatterns[f] >= 0) {
+            mapStream << faultPatterns[f] + 1 << "\n";
+        } else {
+            mapStream << "undetected\n";
+        }
+    }
+
+    std::cout << "Compaction: " << compactor.getCubeCount() << " distinct vectors -> "
+              << compactor.getMergedCount() << " merged cubes -> " << compactor.getPatterns().size()
+              << " patterns. Written to " << patternFile << " (map: " << mapFile << ")" << std::endl;
+    return true;
+}
 
 int main(int argc, char* argv[]) {
     // 1. Check Arguments
-    if (argc != 4) {
-        std::cerr << "Usage: ./my_atpg [bench_file] [output_file] [fault_file]" << std::endl;
-        return 1;
+    if (argc == 6 && std::string(argv[1]) == "--grade") {
+        return runGrading(argv[2], argv[3], argv[4], argv[5]);
     }
 
-    std::string benchFile = argv[1];
-    std::string outputFile = argv[2];
-    std::string faultFile = argv[3];
+    // Options may follow the three file arguments
+    std::vector<std::string> fileArgs;
+    AtpgOptions options;
+    bool collapseFaults = false;
+    bool legacyParser = false;
+    std::string cacheFile;
+    std::string compactFile;
+    std::string binaryFile;
+    std::string statsFile;
+    size_t statsTop = 10;
+    bool serve = false;
+    std::string socketPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--drop") {
+            options.dropFaults = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--guide" && i + 1 < argc) {
+            std::string guide = argv[++i];
+            if (guide != "scoap" && guide != "first") {
+                std::cerr << "Error: Unknown --guide mode " << guide << " (expected scoap or first)" << std::endl;
+                return 1;
+            }
+            options.useScoap = (guide == "scoap");
+        } else if (arg == "--backtrack-limit" && i + 1 < argc) {
+            options.backtrackLimit = std::max(0L, std::atol(argv[++i]));
+        } else if (arg == "--time-limit" && i + 1 < argc) {
+            options.timeLimitMs = std::max(0L, std::atol(argv[++i]));
+        } else if (arg == "--retry" && i + 1 < argc) {
+            options.retryScale = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--dynamic") {
+            options.dynamicCompaction = true;
+        } else if (arg == "--secondary-limit" && i + 1 < argc) {
+            options.secondaryBacktrackLimit = std::max(1L, std::atol(argv[++i]));
+        } else if (arg == "--secondary-targets" && i + 1 < argc) {
+            options.secondaryTargets = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--legacy-parser") {
+            legacyParser = true;
+        } else if (arg == "--netlist-cache" && i + 1 < argc) {
+            cacheFile = argv[++i];
+        } else if (arg == "--collapse") {
+            collapseFaults = true;
+        } else if (arg == "--compact" && i + 1 < argc) {
+            compactFile = argv[++i];
+        } else if (arg == "--binary-patterns" && i + 1 < argc) {
+            binaryFile = argv[++i];
+        } else if (arg == "--quiet") {
+            options.quiet = true;
+        } else if (arg == "--stats" && i + 1 < argc) {
+            statsFile = argv[++i];
+        } else if (arg == "--stats-top" && i + 1 < argc) {
+            statsTop = size_t(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--progress") {
+            options.progress = true;
+        } else if (arg == "--learn") {
+            options.staticLearning = true;
+        } else if (arg == "--learn-time-limit" && i + 1 < argc) {
+            options.learnTimeLimitMs = std::max(0L, std::atol(argv[++i]));
+        } else if (arg == "--serve") {
+            serve = true;
+        } else if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else {
+            fileArgs.push_back(arg);
+        }
+    }
 
-    // 2. Create the Circuit Object
-    Circuit circuit;
-    g_Circuit = &circuit; // Set the global bridge for the parser
+    // Secondary targeting depends on which faults are still undetected
+    if (options.dynamicCompaction && options.threads > 1) {
+        std::cerr << "Note: --dynamic runs single-threaded, ignoring --threads " << options.threads << std::endl;
+        options.threads = 1;
+    }
 
-    // 3. Parse the Bench File
-    FILE* bench = fopen(benchFile.c_str(), "r");
-    if (!bench) {
-        std::cerr << "Error: Cannot open bench file " << benchFile << std::endl;
+    // Server mode: the file arguments are circuits to preload, named after
+    // the file without its directory and extension
+    if (serve) {
+        AtpgServer server(options, legacyParser);
+        for (const std::string& benchFile : fileArgs) {
+            std::string name = std::filesystem::path(benchFile).stem().string();
+            std::string error;
+            if (!server.load(name, benchFile, std::string(), error)) {
+                std::cerr << "Error: " << error << std::endl;
+                return 1;
+            }
+            std::cerr << "Loaded " << benchFile << " as " << name << std::endl;
+        }
+        if (socketPath.empty()) {
+            server.serve(std::cin, std::cout);
+            return 0;
+        }
+        return server.listen(socketPath) ? 0 : 1;
+    }
+
+    // Without a fault file, write the circuit's collapsed fault list
+    if (fileArgs.size() == 2) {
+        std::unique_ptr<Netlist> netlist = loadNetlist(fileArgs[0], legacyParser, cacheFile);
+        if (!netlist) {
+            return 1;
+        }
+        std::ofstream listStream(fileArgs[1]);
+        if (!listStream.is_open()) {
+            std::cerr << "Error: Cannot open output file " << fileArgs[1] << std::endl;
+            return 1;
+        }
+        FaultCollapser collapser(*netlist);
+        int written = collapser.writeCollapsedList(listStream);
+        std::cout << "Collapsed fault list: " << written << " faults (" << collapser.getClassCount()
+                  << " equivalence classes). Written to " << fileArgs[1] << std::endl;
+        reportPeakMemory(*netlist);
+        return 0;
+    }
+
+    if (fileArgs.size() != 3) {
+        std::cerr << "Usage: ./my_atpg [bench_file] [output_file] [fault_file] [--drop] [--threads N] [--guide scoap|first]" << std::endl;
+        std::cerr << "                [--backtrack-limit N] [--time-limit MS] [--retry K] [--collapse] [--compact pattern_file]" << std::endl;
+        std::cerr << "                [--dynamic] [--secondary-limit N] [--secondary-targets N] [--legacy-parser]" << std::endl;
+        std::cerr << "                [--netlist-cache cache_file] [--binary-patterns pattern_file] [--quiet]" << std::endl;
+        std::cerr << "                [--stats stats_file.csv|.json] [--stats-top N] [--progress] [--learn]" << std::endl;
+        std::cerr << "                [--learn-time-limit MS]" << std::endl;
+        std::cerr << "       ./my_atpg [bench_file] [fault_list_file]" << std::endl;
+        std::cerr << "       ./my_atpg --serve [--socket socket_path] [bench_file ...] [ATPG options]" << std::endl;
+        std::cerr << "       ./my_atpg --grade [bench_file] [output_file] [fault_file] [pattern_file]" << std::endl;
         return 1;
     }
-    yyin = bench;
-    yyparse(); // This populates the 'circuit' object via the global pointer
-    fclose(bench);
 
-    // 4. Build the simulation list
-    circuit.buildSimulationList();
-    std::cout << "Circuit parsed and ready." << std::endl;
+    std::string benchFile = fileArgs[0];
+    std::string outputFile = fileArgs[1];
+    std::string faultFile = fileArgs[2];
+
+    // 2. Parse the Bench File (or map its cached netlist) and build the
+    // simulation list
+    std::unique_ptr<Netlist> netlistPtr = loadNetlist(benchFile, legacyParser, cacheFile);
+    if (!netlistPtr) {
+        return 1;
+    }
+    const Netlist& netlist = *netlistPtr;
 
-    // 5. Open Fault and Output Files
+    // 3. Open Fault and Output Files
     std::ifstream faultStream(faultFile);
     std::ofstream outputStream(outputFile);
     
@@ -68,52 +504,106 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // 6. Loop through faults and run solver
+    std::vector<FaultSpec> faults;
     std::string faultGateName;
     int faultVal;
     while (faultStream >> faultGateName >> faultVal) {
-        
-        // Reset all circuit values to UNSET/X
-        circuit.clearAllValues();
-        
-        FaultType fault = (faultVal == 0) ? FaultType::SA0 : FaultType::SA1;
-        
-        try {
-            // Create the solver
-            PodemSolver solver(circuit, faultGateName, fault);
-            
-            // Run the solver
-            std::vector<std::pair<std::string, LogicValue>> testVector;
-            bool success = solver.solve(testVector);
-
-            if (success) {
-                // Print the test vector to the file
-                for (const auto& pi : circuit.getPIs()) {
-                    // Find the value in our testVector map
-                    for (const auto& tv_pair : testVector) {
-                        if (tv_pair.first == pi->getName()) {
-                            outputStream << printPIValue(tv_pair.second);
-                            break;
-                        }
-                    }
-                }
-                outputStream << std::endl;
-                std::cout << "Fault: " << faultGateName << "/" << faultVal << " -> TEST FOUND" << std::endl;
-
-            } else {
-                outputStream << "none found" << std::endl;
-                std::cout << "Fault: " << faultGateName << "/" << faultVal << " -> none found" << std::endl;
-            }
+        faults.push_back({faultGateName, faultVal});
+    }
+
+#ifndef PODEM_STATS
+    if (!statsFile.empty()) {
+        std::cerr << "Error: --stats needs a build with search statistics (cmake -DPODEM_STATS=ON)" << std::endl;
+        return 1;
+    }
+#endif
+    StatsReport statsReport;
+    if (!statsFile.empty() && !statsReport.open(statsFile)) {
+        std::cerr << "Error: Cannot open stats file " << statsFile << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<PatternWriter> binaryPatterns;
+    if (!binaryFile.empty()) {
+        binaryPatterns = std::make_unique<PatternWriter>(netlist);
+        if (!binaryPatterns->open(binaryFile)) {
+            std::cerr << "Error: Cannot open binary pattern file " << binaryFile << std::endl;
+            return 1;
+        }
+    }
+
+    // 4. Run the solver over every fault
+    // Compaction needs the per-fault lines afterwards, so they are
+    // buffered instead of streamed, and the binary file gets the
+    // compacted patterns instead of the per-fault vectors
+    std::stringstream resultBuffer;
+    std::ostream& resultStream = compactFile.empty() ? static_cast<std::ostream&>(outputStream) : resultBuffer;
+    ResultWriter resultWriter(resultStream, compactFile.empty() ? binaryPatterns.get() : nullptr);
+
+    AtpgRunner runner(netlist, options);
+    if (!statsFile.empty()) {
+        runner.setStatsReport(&statsReport);
+    }
+    size_t abortedCount = 0;
+    if (collapseFaults) {
+        runCollapsedAtpg(netlist, runner, faults, resultWriter, abortedCount);
+    } else {
+        runner.run(faults, resultWriter);
+        abortedCount = runner.getAbortedCount();
+    }
+    resultWriter.flush();
 
-        } catch (const std::exception& e) {
-            std::cerr << "Error processing fault " << faultGateName << ": " << e.what() << std::endl;
-            outputStream << "error" << std::endl;
+    if (!compactFile.empty()) {
+        outputStream << resultBuffer.str();
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(resultBuffer, line)) {
+            lines.push_back(line);
+        }
+        if (!writeCompactedPatterns(netlist, faults, lines, compactFile, binaryPatterns.get())) {
+            return 1;
+        }
+    }
+    if (binaryPatterns) {
+        if (!binaryPatterns->close()) {
+            std::cerr << "Error: Cannot write binary pattern file " << binaryFile << std::endl;
+            return 1;
         }
+        std::cout << "Binary patterns: " << binaryPatterns->getPatternCount() << " written to "
+                  << binaryFile << std::endl;
     }
 
     faultStream.close();
     outputStream.close();
 
+    std::cout << "Total backtracks: " << runner.getTotalBacktracks()
+              << " (" << runner.getTotalPruned() << " nodes pruned by the X-path check)" << std::endl;
+    if (const LearnedImplications* learned = runner.getLearnedImplications()) {
+        std::cout << "Static learning: " << learned->getCount() << " implications (" << learned->getConstantCount()
+                  << " constant values) learned in " << std::fixed << std::setprecision(1) << learned->getLearnMs()
+                  << std::defaultfloat << std::setprecision(6) << " ms; " << runner.getTotalLearnedPruned()
+                  << " search nodes cut, " << runner.getRuledOutCount() << " faults ruled out before search"
+                  << std::endl;
+        if (!learned->isComplete()) {
+            std::cout << "Static learning stopped at --learn-time-limit after " << learned->getLearnedGateCount()
+                      << " of " << learned->getTotalGateCount() << " gates" << std::endl;
+        }
+    }
+    if (options.backtrackLimit > 0 || options.timeLimitMs > 0) {
+        std::cout << "Aborted faults: " << abortedCount << std::endl;
+    }
+    if (options.dropFaults || options.dynamicCompaction) {
+        std::cout << "Distinct test vectors: " << runner.getPatternCount() << std::endl;
+    }
+    if (!statsFile.empty()) {
+        if (!statsReport.close()) {
+            std::cerr << "Error: Cannot write stats file " << statsFile << std::endl;
+            return 1;
+        }
+        statsReport.writeSummary(std::cout, statsTop);
+        std::cout << "Per-fault statistics written to " << statsFile << std::endl;
+    }
+    reportPeakMemory(netlist);
     std::cout << "ATPG complete. Results in " << outputFile << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -4,23 +4,28 @@
 #include <vector>
 #include "logic.h"
 #include "Circuit.h"
-#include "parser_bridge.h" // For g_Circuit
 
 // External C function prototypes
 extern "C" int yylex();
-extern "C" int yyparse(); // C-style function name for linking
 extern "C" FILE *yyin;
-void yyerror(const char *s);
-
-// A global vector to hold the list of input names
-std::vector<std::string> g_InputList;
+void yyerror(Circuit& circuit, const char *s);
 %}
 
+/* The circuit being built is passed in, so there is no global bridge:
+   yyparse(circuit) */
+%code requires {
+#include <string>
+#include <vector>
+class Circuit;
+}
+%parse-param { Circuit& circuit }
+
 /* --- Bison Union --- */
 /* This defines what types of data our tokens can hold */
 %union {
     std::string* str;       // For identifiers (gate names)
     GateType     gateType;  // For GATETYPE tokens
+    std::vector<std::string>* names; // For the input list of a gate
 }
 
 /* --- Token Definitions --- */
@@ -31,6 +36,7 @@ std::vector<std::string> g_InputList;
 
 /* --- Grammar Rules --- */
 %type <str> id_list_item
+%type <names> id_list
 
 
 
@@ -52,14 +58,14 @@ line:
 /* Rule for INPUT(gateName) */
 input_line:
     INPUT LPAREN IDENTIFIER RPAREN {
-        g_Circuit->addGate(*$3, GateType::PI);
+        circuit.addGate(*$3, GateType::PI);
         delete $3; // Free the string memory
     };
 
 /* Rule for OUTPUT(gateName) */
 output_line:
     OUTPUT LPAREN IDENTIFIER RPAREN {
-        g_Circuit->addOutput(*$3);
+        circuit.addOutput(*$3);
         delete $3; // Free the string memory
     };
 
@@ -67,29 +73,30 @@ output_line:
 assign_line:
     IDENTIFIER EQUALS GATETYPE LPAREN id_list RPAREN {
         // 1. Create the destination gate
-        g_Circuit->addGate(*$1, $3);
+        circuit.addGate(*$1, $3);
         
-        // 2. Connect all inputs from the global list
-        for (const std::string& inputName : g_InputList) {
+        // 2. Connect all inputs from the list
+        for (const std::string& inputName : *$5) {
             // Ensure the input gate exists (create if not)
-            g_Circuit->addGate(inputName, GateType::BUFF); // Type doesn't matter here
+            circuit.addGate(inputName, GateType::BUFF); // Type doesn't matter here
             // Connect it
-            g_Circuit->connect(inputName, *$1);
+            circuit.connect(inputName, *$1);
         }
         
         // 3. Clean up
-        g_InputList.clear();
+        delete $5;
         delete $1; // Free the string memory
     };
 
 /* Rule to build the list of inputs */
 id_list:
     id_list_item {
-        g_InputList.push_back(*$1);
+        $$ = new std::vector<std::string>(1, *$1);
         delete $1;
     }
     | id_list COMMA id_list_item {
-        g_InputList.push_back(*$3);
+        $$ = $1;
+        $$->push_back(*$3);
         delete $3;
     }
     ;
@@ -104,6 +111,6 @@ id_list_item:
 #include <iostream> // <--- THIS IS THE FIX
 
 /* The error-reporting function */
-void yyerror(const char *s) {
+void yyerror(Circuit&, const char *s) {
     std::cerr << "Parser Error: " << s << std::endl;
 }
\ No newline at end of file